@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_ACCUMULATORDELTA_H
+#define MANTARAY_ACCUMULATORDELTA_H
+
+#include <array>
+#include <cstdint>
+
+#include "AccumulatorOperation.h"
+
+namespace MantaRay
+{
+
+    /// \brief A piece on a square, as seen by the input layer.
+    /// \details This struct identifies a single input feature independent of perspective.
+    struct PieceFeature
+    {
+
+        uint8_t Piece ;
+        uint8_t Color ;
+        uint8_t Square;
+
+    };
+
+    /// \brief The changes made to an accumulator by a single move.
+    /// \details This class records which features a move activated and deactivated, without touching the
+    ///          accumulator itself. It is used to defer accumulator updates until the accumulator is actually needed.
+    ///          A single move never activates or deactivates more than two features (castling moves two pieces,
+    ///          a capturing promotion removes two pieces and adds one), which bounds the size of the record. Changes
+    ///          beyond that bound are rejected rather than recorded.
+    class AccumulatorDelta
+    {
+
+        public:
+            constexpr static uint8_t MaxChanges = 2;
+
+            std::array<PieceFeature, MaxChanges> Activated  ;
+            std::array<PieceFeature, MaxChanges> Deactivated;
+
+            uint8_t ActivatedCount   = 0;
+            uint8_t DeactivatedCount = 0;
+
+            /// \brief Clears the recorded changes.
+            inline void Clear()
+            {
+                ActivatedCount   = 0;
+                DeactivatedCount = 0;
+            }
+
+            /// \brief Records a feature activation or deactivation.
+            /// \tparam Operation The operation performed on the feature.
+            /// \param piece The piece that is inserted or removed.
+            /// \param color The color of the piece that is inserted or removed.
+            /// \param sq The square the piece is inserted or removed from.
+            /// \return True if the change was recorded, false if the record for the operation is already full (in
+            ///         which case nothing is written).
+            template<AccumulatorOperation Operation>
+            [[nodiscard]] inline bool Record(const uint8_t piece, const uint8_t color, const uint8_t sq)
+            {
+                if (Operation == AccumulatorOperation::Activate) {
+                    if (ActivatedCount == MaxChanges) return false;
+
+                    Activated[ActivatedCount++] = { piece, color, sq };
+                } else {
+                    if (DeactivatedCount == MaxChanges) return false;
+
+                    Deactivated[DeactivatedCount++] = { piece, color, sq };
+                }
+
+                return true;
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_ACCUMULATORDELTA_H
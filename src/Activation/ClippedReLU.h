@@ -6,14 +6,32 @@
 #ifndef MANTARAY_CLIPPEDRELU_H
 #define MANTARAY_CLIPPEDRELU_H
 
+#include <cstdint>
 #include <utility>
+#include <algorithm>
 
-#ifdef __AVX512BW__
+#include "../Backend/Dispatch.h"
+
+#ifdef MANTARAY_AVX512_VNNI
+#include "../Backend/Avx512Vnni.h"
+#endif
+
+#ifdef MANTARAY_AVX512
 #include "../Backend/Avx512.h"
-#elifdef __AVX2__
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+#include "../Backend/AvxVnni.h"
+#endif
+
+#ifdef MANTARAY_AVX2
 #include "../Backend/Avx2.h"
 #endif
 
+#ifdef MANTARAY_SSE
+#include "../Backend/Sse.h"
+#endif
+
 namespace MantaRay
 {
 
@@ -22,13 +40,27 @@ namespace MantaRay
     /// \tparam Minimum The minimum value to return.
     /// \tparam Maximum The maximum value to return.
     /// \details Calling the static Activate function will provide the clipped ReLU of the input.
-    ///          The input is clipped to the range [Minimum, Maximum].
+    ///          The input is clipped to the range [Minimum, Maximum]. Calling the static
+    ///          ActivateMultiplyAndAddAdjacent (or ActivateAndMultiply) function will provide the product of the
+    ///          activated input and the weight, as used by the forward propagation.
     template<typename T, T Minimum, T Maximum>
     class ClippedReLU
     {
 
         public:
-#ifdef __AVX512BW__
+            /// \brief The factor the sum of the activated products is divided by before the bias is added.
+            constexpr static T Divisor = 1;
+
+            /// \brief Activates a single value of a hidden layer.
+            /// \param arg The value to activate.
+            /// \return The clipped value, at the same quantization as the input.
+            static inline T Apply(const T arg)
+            {
+                return std::max(Minimum, std::min(Maximum, arg));
+            }
+
+#ifdef MANTARAY_AVX512
+            MANTARAY_TARGET_AVX512
             static inline Vec512I Activate(const Vec512I& arg)
             {
                 const Vec512I min = Avx512<T>::From(Minimum);
@@ -36,7 +68,25 @@ namespace MantaRay
 
                 return Avx512<T>::Max(min, Avx512<T>::Min(max, arg));
             }
-#elifdef __AVX2__
+
+            MANTARAY_TARGET_AVX512
+            static inline Vec512I ActivateMultiplyAndAddAdjacent(const Vec512I& arg, const Vec512I& weight)
+            {
+                return Avx512<T>::MultiplyAndAddAdjacent(Activate(arg), weight);
+            }
+#endif
+
+#ifdef MANTARAY_AVX512_VNNI
+            MANTARAY_TARGET_AVX512_VNNI
+            static inline Vec512I ActivateMultiplyAddAdjacentAndAccumulate(const Vec512I& sum, const Vec512I& arg,
+                                                                           const Vec512I& weight)
+            {
+                return Avx512Vnni<T>::MultiplyAddAdjacentAndAccumulate(sum, Activate(arg), weight);
+            }
+#endif
+
+#ifdef MANTARAY_AVX2
+            MANTARAY_TARGET_AVX2
             static inline Vec256I Activate(const Vec256I& arg)
             {
                 const Vec256I min = Avx<T>::From(Minimum);
@@ -44,12 +94,49 @@ namespace MantaRay
 
                 return Avx2<T>::Max(min, Avx2<T>::Min(max, arg));
             }
-#else
+
+            MANTARAY_TARGET_AVX2
+            static inline Vec256I ActivateMultiplyAndAddAdjacent(const Vec256I& arg, const Vec256I& weight)
+            {
+                return Avx2<T>::MultiplyAndAddAdjacent(Activate(arg), weight);
+            }
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+            MANTARAY_TARGET_AVX_VNNI
+            static inline Vec256I ActivateMultiplyAddAdjacentAndAccumulate(const Vec256I& sum, const Vec256I& arg,
+                                                                           const Vec256I& weight)
+            {
+                return AvxVnni<T>::MultiplyAddAdjacentAndAccumulate(sum, Activate(arg), weight);
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            MANTARAY_TARGET_SSE
+            static inline Vec128I Activate(const Vec128I& arg)
+            {
+                const Vec128I min = Sse<T>::From(Minimum);
+                const Vec128I max = Sse<T>::From(Maximum);
+
+                return Sse<T>::Max(min, Sse<T>::Min(max, arg));
+            }
+
+            MANTARAY_TARGET_SSE
+            static inline Vec128I ActivateMultiplyAndAddAdjacent(const Vec128I& arg, const Vec128I& weight)
+            {
+                return Sse<T>::MultiplyAndAddAdjacent(Activate(arg), weight);
+            }
+#endif
+
             static inline T Activate(const T arg)
             {
                 return std::max(Minimum, std::min(Maximum, arg));
             }
-#endif
+
+            static inline int32_t ActivateAndMultiply(const T arg, const T weight)
+            {
+                return Activate(arg) * weight;
+            }
 
     };
 
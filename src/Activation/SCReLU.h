@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_SCRELU_H
+#define MANTARAY_SCRELU_H
+
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+#include "../Backend/Dispatch.h"
+
+#ifdef MANTARAY_AVX512_VNNI
+#include "../Backend/Avx512Vnni.h"
+#endif
+
+#ifdef MANTARAY_AVX512
+#include "../Backend/Avx512.h"
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+#include "../Backend/AvxVnni.h"
+#endif
+
+#ifdef MANTARAY_AVX2
+#include "../Backend/Avx2.h"
+#endif
+
+#ifdef MANTARAY_SSE
+#include "../Backend/Sse.h"
+#endif
+
+namespace MantaRay
+{
+
+    /// \brief Squared Clipped Rectified Linear Unit (SCReLU) activation function.
+    /// \tparam T The type of the input and output.
+    /// \tparam Minimum The minimum value to clip to.
+    /// \tparam Maximum The maximum value to clip to.
+    /// \details Calling the static Activate function will provide the clipped ReLU of the input, which is squared as
+    ///          part of the forward propagation: calling the static ActivateMultiplyAndAddAdjacent (or
+    ///          ActivateAndMultiply) function will provide clamp(x) * clamp(x) * weight.
+    ///
+    ///          The square of the clipped input doesn't fit the input type, so the product is computed as
+    ///          (clamp(x) * weight) * clamp(x): the first product is kept in the input type, and the second is widened
+    ///          to the output type by the adjacent multiply-add. This requires Maximum * |weight| to fit the input
+    ///          type (for example, Maximum = 255 and |weight| <= 127 for int16_t).
+    ///
+    ///          Squaring the clipped input raises its quantization from Maximum to Maximum * Maximum, so the sum of the
+    ///          products is divided by Maximum before the bias is added. The network's input quantization factor is
+    ///          thus expected to be Maximum.
+    template<typename T, T Minimum, T Maximum>
+    class SCReLU
+    {
+
+        public:
+            /// \brief The factor the sum of the activated products is divided by before the bias is added.
+            constexpr static T Divisor = Maximum;
+
+            /// \brief Activates a single value of a hidden layer.
+            /// \param arg The value to activate.
+            /// \return The squared clipped value, divided by Maximum to keep the same quantization as the input.
+            static inline T Apply(const T arg)
+            {
+                const T clipped = std::max(Minimum, std::min(Maximum, arg));
+
+                return clipped * clipped / Maximum;
+            }
+
+#ifdef MANTARAY_AVX512
+            MANTARAY_TARGET_AVX512
+            static inline Vec512I Activate(const Vec512I& arg)
+            {
+                const Vec512I min = Avx512<T>::From(Minimum);
+                const Vec512I max = Avx512<T>::From(Maximum);
+
+                return Avx512<T>::Max(min, Avx512<T>::Min(max, arg));
+            }
+
+            MANTARAY_TARGET_AVX512
+            static inline Vec512I ActivateMultiplyAndAddAdjacent(const Vec512I& arg, const Vec512I& weight)
+            {
+                const Vec512I clipped = Activate(arg);
+
+                return Avx512<T>::MultiplyAndAddAdjacent(Avx512<T>::MultiplyLow(clipped, weight), clipped);
+            }
+#endif
+
+#ifdef MANTARAY_AVX512_VNNI
+            MANTARAY_TARGET_AVX512_VNNI
+            static inline Vec512I ActivateMultiplyAddAdjacentAndAccumulate(const Vec512I& sum, const Vec512I& arg,
+                                                                           const Vec512I& weight)
+            {
+                const Vec512I clipped = Activate(arg);
+
+                return Avx512Vnni<T>::MultiplyAddAdjacentAndAccumulate(sum, Avx512<T>::MultiplyLow(clipped, weight),
+                                                                       clipped);
+            }
+#endif
+
+#ifdef MANTARAY_AVX2
+            MANTARAY_TARGET_AVX2
+            static inline Vec256I Activate(const Vec256I& arg)
+            {
+                const Vec256I min = Avx<T>::From(Minimum);
+                const Vec256I max = Avx<T>::From(Maximum);
+
+                return Avx2<T>::Max(min, Avx2<T>::Min(max, arg));
+            }
+
+            MANTARAY_TARGET_AVX2
+            static inline Vec256I ActivateMultiplyAndAddAdjacent(const Vec256I& arg, const Vec256I& weight)
+            {
+                const Vec256I clipped = Activate(arg);
+
+                return Avx2<T>::MultiplyAndAddAdjacent(Avx2<T>::MultiplyLow(clipped, weight), clipped);
+            }
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+            MANTARAY_TARGET_AVX_VNNI
+            static inline Vec256I ActivateMultiplyAddAdjacentAndAccumulate(const Vec256I& sum, const Vec256I& arg,
+                                                                           const Vec256I& weight)
+            {
+                const Vec256I clipped = Activate(arg);
+
+                return AvxVnni<T>::MultiplyAddAdjacentAndAccumulate(sum, Avx2<T>::MultiplyLow(clipped, weight),
+                                                                    clipped);
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            MANTARAY_TARGET_SSE
+            static inline Vec128I Activate(const Vec128I& arg)
+            {
+                const Vec128I min = Sse<T>::From(Minimum);
+                const Vec128I max = Sse<T>::From(Maximum);
+
+                return Sse<T>::Max(min, Sse<T>::Min(max, arg));
+            }
+
+            MANTARAY_TARGET_SSE
+            static inline Vec128I ActivateMultiplyAndAddAdjacent(const Vec128I& arg, const Vec128I& weight)
+            {
+                const Vec128I clipped = Activate(arg);
+
+                return Sse<T>::MultiplyAndAddAdjacent(Sse<T>::MultiplyLow(clipped, weight), clipped);
+            }
+#endif
+
+            static inline T Activate(const T arg)
+            {
+                return std::max(Minimum, std::min(Maximum, arg));
+            }
+
+            static inline int32_t ActivateAndMultiply(const T arg, const T weight)
+            {
+                const int32_t clipped = Activate(arg);
+
+                return clipped * clipped * weight;
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_SCRELU_H
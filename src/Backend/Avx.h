@@ -27,6 +27,7 @@ namespace MantaRay
         public:
             /// \brief Load an AVX register with zeros.
             /// \return An AVX register filled with zeros of the type T.
+            MANTARAY_TARGET_AVX2
             static inline Vec256I Zero()
             {
                 return _mm256_setzero_si256();
@@ -37,6 +38,7 @@ namespace MantaRay
             /// \return An AVX register loaded with the provided value.
             /// \details This function loads the provided value of type T into an AVX register, duplicating the value
             ///          across the register as necessary.
+            MANTARAY_TARGET_AVX2
             static inline Vec256I From(const T value)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm256_set1_epi8 (value);
@@ -55,6 +57,7 @@ namespace MantaRay
             ///          index. The array must have at least 32 bytes of memory allocated starting from the provided
             ///          index.
             template<size_t Size>
+            MANTARAY_TARGET_AVX2
             static inline Vec256I From(const std::array<T, Size>& array, const uint32_t index)
             {
                 static_assert(sizeof(array) >= 32, "Array must be at least 32 bytes in size.");
@@ -71,6 +74,7 @@ namespace MantaRay
             ///          the provided index. The array must have at least 32 bytes of memory allocated starting from the
             ///          provided index.
             template<size_t Size>
+            MANTARAY_TARGET_AVX2
             static inline void Store(const Vec256I& ymm0, std::array<T, Size>& array, const uint32_t index)
             {
                 static_assert(sizeof(array) >= 32, "Array must be at least 32 bytes in size.");
@@ -31,6 +31,7 @@ namespace MantaRay
             ///          minimum values are determined by comparing the values of the two registers at each index and
             ///          storing the minimum value at that index in the returned register. The returned register will
             ///          contain the minimum values of the two provided registers at each index.
+            MANTARAY_TARGET_AVX2
             static inline Vec256I Min(const Vec256I& ymm0, const Vec256I& ymm1)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm256_min_epi8 (ymm0, ymm1);
@@ -48,6 +49,7 @@ namespace MantaRay
             ///          maximum values are determined by comparing the values of the two registers at each index and
             ///          storing the maximum value at that index in the returned register. The returned register will
             ///          contain the maximum values of the two provided registers at each index.
+            MANTARAY_TARGET_AVX2
             static inline Vec256I Max(const Vec256I& ymm0, const Vec256I& ymm1)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm256_max_epi8 (ymm0, ymm1);
@@ -65,6 +67,7 @@ namespace MantaRay
             ///          determined by adding the values of the two registers at each index and storing the sum at that
             ///          index in the returned register. The returned register will contain the sum of the two provided
             ///          registers at each index.
+            MANTARAY_TARGET_AVX2
             static inline Vec256I Add(const Vec256I& ymm0, const Vec256I& ymm1)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm256_add_epi8 (ymm0, ymm1);
@@ -82,6 +85,7 @@ namespace MantaRay
             ///          difference is determined by subtracting the values of the two registers at each index and
             ///          storing the difference at that index in the returned register. The returned register will
             ///          contain the difference of the two provided registers at each index.
+            MANTARAY_TARGET_AVX2
             static inline Vec256I Subtract(const Vec256I& ymm0, const Vec256I& ymm1)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm256_sub_epi8 (ymm0, ymm1);
@@ -91,6 +95,21 @@ namespace MantaRay
                 if (std::is_same_v<T, int32_t>) return _mm256_sub_epi32(ymm0, ymm1);
             }
 
+            /// \brief Multiply the two provided registers, keeping the lower bits of the products.
+            /// \param ymm0 The first register.
+            /// \param ymm1 The second register.
+            /// \return A register with the products of the two provided registers.
+            /// \details This function returns a register with the products of the values of the two registers at each
+            ///          index. Only the lower bits of every product are kept, so the products must fit the provided
+            ///          type.
+            MANTARAY_TARGET_AVX2
+            static inline Vec256I MultiplyLow(const Vec256I& ymm0, const Vec256I& ymm1)
+            {
+                static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                return _mm256_mullo_epi16(ymm0, ymm1);
+            }
+
             /// \brief Multiply the two provided registers and add the values at adjacent indices.
             /// \param ymm0 The first register.
             /// \param ymm1 The second register.
@@ -99,12 +118,42 @@ namespace MantaRay
             ///          The products are determined by multiplying the values of the two registers at each index and
             ///          then summing it up with the product of the values at the adjacent index. The returned register
             ///          will be of a different type than the provided registers: doubling the bits of the provided
-            ///          type.
+            ///          type. For int8_t, the values of the first register are treated as unsigned, and the sums
+            ///          saturate to the range of int16_t.
+            MANTARAY_TARGET_AVX2
             static inline Vec256I MultiplyAndAddAdjacent(const Vec256I& ymm0, const Vec256I& ymm1)
+            {
+                static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                if (std::is_same_v<T, int8_t> ) return _mm256_maddubs_epi16(ymm0, ymm1);
+
+                if (std::is_same_v<T, int16_t>) return _mm256_madd_epi16(ymm0, ymm1);
+            }
+
+            /// \brief Pack the two provided registers into a register of half the type's bits.
+            /// \param ymm0 The register holding the first half of the values.
+            /// \param ymm1 The register holding the second half of the values.
+            /// \return A register with the values of both registers, in order, saturated to half the type's bits.
+            MANTARAY_TARGET_AVX2
+            static inline Vec256I Pack(const Vec256I& ymm0, const Vec256I& ymm1)
             {
                 static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
 
-                return _mm256_madd_epi16(ymm0, ymm1);
+                // Packing works within 128-bit lanes, so restore the order of the 64-bit blocks afterwards:
+                return _mm256_permute4x64_epi64(_mm256_packs_epi16(ymm0, ymm1), 0b11011000);
+            }
+
+            /// \brief Get a mask of the non-zero values of the provided register.
+            /// \param ymm0 The register.
+            /// \return A mask with the bit of every index set if the value at that index is non-zero.
+            MANTARAY_TARGET_AVX2
+            static inline uint32_t NonZeroMask(const Vec256I& ymm0)
+            {
+                static_assert(std::is_same_v<T, int32_t>, "Unsupported type provided.");
+
+                // Compare every value with zero, and invert the resulting sign-bit mask:
+                const Vec256I zero = _mm256_setzero_si256();
+                return ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(ymm0, zero))) & 0xFF;
             }
 
             /// \brief Horizontally add the values of the provided register.
@@ -112,6 +161,7 @@ namespace MantaRay
             /// \return The sum of the values of the provided register.
             /// \details This function returns the sum of the values of the provided register. The sum is determined by
             ///          accumulating the values in the register.
+            MANTARAY_TARGET_AVX2
             static inline T Sum(const Vec256I& ymm0)
             {
                 static_assert(std::is_same_v<T, int32_t>, "Unsupported type provided.");
@@ -143,6 +193,38 @@ namespace MantaRay
                 return _mm_cvtsi128_si32(xmm0);
             }
 
+            /// \brief Horizontally add the values of each of the eight provided registers.
+            /// \param ymm The registers.
+            /// \return A register with the sum of the values of every provided register, in order.
+            /// \details This function transposes the registers while adding them (within each 128-bit lane, and then
+            ///          across the lanes), so that the eight sums are computed together with a fraction of the
+            ///          instructions of eight separate horizontal additions.
+            MANTARAY_TARGET_AVX2
+            static inline Vec256I Sum(const Vec256I (&ymm)[8])
+            {
+                static_assert(std::is_same_v<T, int32_t>, "Unsupported type provided.");
+
+                // Define the registers used in the horizontal addition:
+                Vec256I pairs[4];
+                Vec256I quads[2];
+
+                // Interleave the 32-bit values of every pair of registers, and add the halves vertically, leaving the
+                // two partial sums of both registers in each lane:
+                for (size_t i = 0; i < 4; i++)
+                    pairs[i] = _mm256_add_epi32(_mm256_unpacklo_epi32(ymm[i * 2], ymm[i * 2 + 1]),
+                                                _mm256_unpackhi_epi32(ymm[i * 2], ymm[i * 2 + 1]));
+
+                // Interleave the 64-bit values of every pair of registers, and add the halves vertically, leaving the
+                // partial sum of four registers, in order, in each lane:
+                for (size_t i = 0; i < 2; i++)
+                    quads[i] = _mm256_add_epi32(_mm256_unpacklo_epi64(pairs[i * 2], pairs[i * 2 + 1]),
+                                                _mm256_unpackhi_epi64(pairs[i * 2], pairs[i * 2 + 1]));
+
+                // Gather the lower and upper lanes of both registers, and add them vertically:
+                return _mm256_add_epi32(_mm256_permute2x128_si256(quads[0], quads[1], 0x20),
+                                        _mm256_permute2x128_si256(quads[0], quads[1], 0x31));
+            }
+
     };
 
 } // MantaRay
@@ -25,6 +25,7 @@ namespace MantaRay
         public:
             /// \brief Load an AVX512 register with zeros.
             /// \return An AVX512 register filled with zeros of the type T.
+            MANTARAY_TARGET_AVX512
             static inline Vec512I Zero()
             {
                 return _mm512_setzero_si512();
@@ -35,6 +36,7 @@ namespace MantaRay
             /// \return An AVX512 register loaded with the provided value.
             /// \details This function loads the provided value of type T into an AVX512 register, duplicating the value
             ///          across the register as necessary.
+            MANTARAY_TARGET_AVX512
             static inline Vec512I From(const T value)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm512_set1_epi8 (value);
@@ -53,6 +55,7 @@ namespace MantaRay
             ///          provided index. The array must have at least 32 bytes of memory allocated starting from the
             ///          provided index.
             template<size_t Size>
+            MANTARAY_TARGET_AVX512
             static inline Vec512I From(const std::array<T, Size>& array, const uint32_t index)
             {
                 return _mm512_load_si512((Vec512I const*) &array[index]);
@@ -67,6 +70,7 @@ namespace MantaRay
             ///          at the provided index. The array must have at least 32 bytes of memory allocated starting from
             ///          the provided index.
             template<size_t Size>
+            MANTARAY_TARGET_AVX512
             static inline void Store(const Vec512I& zmm0, std::array<T, Size>& array, const uint32_t index)
             {
                 _mm512_store_si512((Vec512I *) &array[index], zmm0);
@@ -80,6 +84,7 @@ namespace MantaRay
             ///          minimum values are determined by comparing the values of the two registers at each index and
             ///          storing the minimum value at that index in the returned register. The returned register will
             ///          contain the minimum values of the two provided registers at each index.
+            MANTARAY_TARGET_AVX512
             static inline Vec512I Min(const Vec512I& zmm0, const Vec512I& zmm1)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm512_min_epi8 (zmm0, zmm1);
@@ -97,6 +102,7 @@ namespace MantaRay
             ///          maximum values are determined by comparing the values of the two registers at each index and
             ///          storing the maximum value at that index in the returned register. The returned register will
             ///          contain the maximum values of the two provided registers at each index.
+            MANTARAY_TARGET_AVX512
             static inline Vec512I Max(const Vec512I& zmm0, const Vec512I& zmm1)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm512_max_epi8 (zmm0, zmm1);
@@ -114,6 +120,7 @@ namespace MantaRay
             ///          determined by adding the values of the two registers at each index and storing the sum at that
             ///          index in the returned register. The returned register will contain the sum of the two provided
             ///          registers at each index.
+            MANTARAY_TARGET_AVX512
             static inline Vec512I Add(const Vec512I& zmm0, const Vec512I& zmm1)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm512_add_epi8 (zmm0, zmm1);
@@ -131,6 +138,7 @@ namespace MantaRay
             ///          difference is determined by subtracting the values of the two registers at each index and
             ///          storing the difference at that index in the returned register. The returned register will
             ///          contain the difference of the two provided registers at each index.
+            MANTARAY_TARGET_AVX512
             static inline Vec512I Subtract(const Vec512I& zmm0, const Vec512I& zmm1)
             {
                 if (std::is_same_v<T, int8_t> ) return _mm512_sub_epi8 (zmm0, zmm1);
@@ -140,6 +148,21 @@ namespace MantaRay
                 if (std::is_same_v<T, int32_t>) return _mm512_sub_epi32(zmm0, zmm1);
             }
 
+            /// \brief Multiply the two provided registers, keeping the lower bits of the products.
+            /// \param zmm0 The first register.
+            /// \param zmm1 The second register.
+            /// \return A register with the products of the two provided registers.
+            /// \details This function returns a register with the products of the values of the two registers at each
+            ///          index. Only the lower bits of every product are kept, so the products must fit the provided
+            ///          type.
+            MANTARAY_TARGET_AVX512
+            static inline Vec512I MultiplyLow(const Vec512I& zmm0, const Vec512I& zmm1)
+            {
+                static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                return _mm512_mullo_epi16(zmm0, zmm1);
+            }
+
             /// \brief Multiply the two provided registers and add the values at adjacent indices.
             /// \param ymm0 The first register.
             /// \param ymm1 The second register.
@@ -148,12 +171,41 @@ namespace MantaRay
             ///          The products are determined by multiplying the values of the two registers at each index and
             ///          then summing it up with the product of the values at the adjacent index. The returned register
             ///          will be of a different type than the provided registers: doubling the bits of the provided
-            ///          type.
+            ///          type. For int8_t, the values of the first register are treated as unsigned, and the sums
+            ///          saturate to the range of int16_t.
+            MANTARAY_TARGET_AVX512
             static inline Vec512I MultiplyAndAddAdjacent(const Vec512I& zmm0, const Vec512I& zmm1)
+            {
+                static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                if (std::is_same_v<T, int8_t> ) return _mm512_maddubs_epi16(zmm0, zmm1);
+
+                if (std::is_same_v<T, int16_t>) return _mm512_madd_epi16(zmm0, zmm1);
+            }
+
+            /// \brief Pack the two provided registers into a register of half the type's bits.
+            /// \param zmm0 The register holding the first half of the values.
+            /// \param zmm1 The register holding the second half of the values.
+            /// \return A register with the values of both registers, in order, saturated to half the type's bits.
+            MANTARAY_TARGET_AVX512
+            static inline Vec512I Pack(const Vec512I& zmm0, const Vec512I& zmm1)
             {
                 static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
 
-                return _mm512_madd_epi16(zmm0, zmm1);
+                // Packing works within 128-bit lanes, so restore the order of the 64-bit blocks afterwards:
+                return _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7),
+                                                _mm512_packs_epi16(zmm0, zmm1));
+            }
+
+            /// \brief Get a mask of the non-zero values of the provided register.
+            /// \param zmm0 The register.
+            /// \return A mask with the bit of every index set if the value at that index is non-zero.
+            MANTARAY_TARGET_AVX512
+            static inline uint32_t NonZeroMask(const Vec512I& zmm0)
+            {
+                static_assert(std::is_same_v<T, int32_t>, "Unsupported type provided.");
+
+                return _mm512_test_epi32_mask(zmm0, zmm0);
             }
 
             /// \brief Horizontally add the values of the provided register.
@@ -164,6 +216,7 @@ namespace MantaRay
             ///          then calculating the sum of the resulting AVX2 register.
             /// \see MantaRay::Backend::Avx2::Add(const Vec256I& ymm0, const Vec256I& ymm1)
             /// \see MantaRay::Backend::Avx2::Sum(const Vec256I& ymm0)
+            MANTARAY_TARGET_AVX512
             static inline T Sum(const Vec512I& zmm0)
             {
                 static_assert(std::is_same_v<T, int32_t>, "Unsupported type provided.");
@@ -183,6 +236,44 @@ namespace MantaRay
                 return Avx2<T>::Sum(ymm0);
             }
 
+            /// \brief Horizontally add the values of each of the sixteen provided registers.
+            /// \param zmm The registers.
+            /// \return A register with the sum of the values of every provided register, in order.
+            /// \details This function transposes the registers while adding them (within each 128-bit lane, and then
+            ///          across the lanes), so that the sixteen sums are computed together with a fraction of the
+            ///          instructions of sixteen separate horizontal additions.
+            MANTARAY_TARGET_AVX512
+            static inline Vec512I Sum(const Vec512I (&zmm)[16])
+            {
+                static_assert(std::is_same_v<T, int32_t>, "Unsupported type provided.");
+
+                // Define the registers used in the horizontal addition:
+                Vec512I pairs[8];
+                Vec512I quads[4];
+                Vec512I halves[2];
+
+                // Interleave the 32-bit values of every pair of registers, and add the halves vertically, leaving the
+                // two partial sums of both registers in each lane:
+                for (size_t i = 0; i < 8; i++)
+                    pairs[i] = _mm512_add_epi32(_mm512_unpacklo_epi32(zmm[i * 2], zmm[i * 2 + 1]),
+                                                _mm512_unpackhi_epi32(zmm[i * 2], zmm[i * 2 + 1]));
+
+                // Interleave the 64-bit values of every pair of registers, and add the halves vertically, leaving the
+                // partial sum of four registers, in order, in each lane:
+                for (size_t i = 0; i < 4; i++)
+                    quads[i] = _mm512_add_epi32(_mm512_unpacklo_epi64(pairs[i * 2], pairs[i * 2 + 1]),
+                                                _mm512_unpackhi_epi64(pairs[i * 2], pairs[i * 2 + 1]));
+
+                // Gather the lower and upper two lanes of every pair of registers, and add them vertically:
+                for (size_t i = 0; i < 2; i++)
+                    halves[i] = _mm512_add_epi32(_mm512_shuffle_i32x4(quads[i * 2], quads[i * 2 + 1], 0x44),
+                                                 _mm512_shuffle_i32x4(quads[i * 2], quads[i * 2 + 1], 0xEE));
+
+                // Gather the even and odd lanes of both registers, and add them vertically:
+                return _mm512_add_epi32(_mm512_shuffle_i32x4(halves[0], halves[1], 0x88),
+                                        _mm512_shuffle_i32x4(halves[0], halves[1], 0xDD));
+            }
+
     };
 
 } // MantaRay
@@ -0,0 +1,48 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_AVX512VNNI_H
+#define MANTARAY_AVX512VNNI_H
+
+#include "Avx512.h"
+
+namespace MantaRay
+{
+
+    /// \brief AVX512 VNNI Intrinsics wrapper.
+    /// \tparam T Type of the data.
+    /// \details This class is a wrapper for the AVX512 VNNI intrinsics, which fuse the adjacent multiply-add of
+    ///          Avx512 with the accumulation of its result. The remaining operations are provided by Avx512.
+    template<typename T>
+    class Avx512Vnni
+    {
+
+        static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+        public:
+            /// \brief Multiply the two provided registers, add the values at adjacent indices, and accumulate them.
+            /// \param zmm0 The register to accumulate into.
+            /// \param zmm1 The first register.
+            /// \param zmm2 The second register.
+            /// \return The accumulation register with the sums of the products of the two provided registers added.
+            /// \details This function multiplies the values of the two registers at each index, sums up the products
+            ///          of every group of adjacent indices filling a 32-bit value (four for int8_t, two for int16_t),
+            ///          and adds the sums to the 32-bit values of the accumulation register. For int8_t, the values of
+            ///          the first register are treated as unsigned. Unlike Avx512::MultiplyAndAddAdjacent, no
+            ///          intermediate sum saturates.
+            MANTARAY_TARGET_AVX512_VNNI
+            static inline Vec512I MultiplyAddAdjacentAndAccumulate(const Vec512I& zmm0, const Vec512I& zmm1,
+                                                                   const Vec512I& zmm2)
+            {
+                if (std::is_same_v<T, int8_t> ) return _mm512_dpbusd_epi32(zmm0, zmm1, zmm2);
+
+                if (std::is_same_v<T, int16_t>) return _mm512_dpwssd_epi32(zmm0, zmm1, zmm2);
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_AVX512VNNI_H
@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_AVXVNNI_H
+#define MANTARAY_AVXVNNI_H
+
+#include "Avx2.h"
+
+namespace MantaRay
+{
+
+    /// \brief AVX-VNNI Intrinsics wrapper.
+    /// \tparam T Type of the data.
+    /// \details This class is a wrapper for the AVX-VNNI intrinsics (the VEX-encoded VNNI instructions of processors
+    ///          without AVX512), which fuse the adjacent multiply-add of Avx2 with the accumulation of its result. The
+    ///          remaining operations are provided by Avx and Avx2.
+    template<typename T>
+    class AvxVnni
+    {
+
+        static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+        public:
+            /// \brief Multiply the two provided registers, add the values at adjacent indices, and accumulate them.
+            /// \param ymm0 The register to accumulate into.
+            /// \param ymm1 The first register.
+            /// \param ymm2 The second register.
+            /// \return The accumulation register with the sums of the products of the two provided registers added.
+            /// \details This function multiplies the values of the two registers at each index, sums up the products
+            ///          of every group of adjacent indices filling a 32-bit value (four for int8_t, two for int16_t),
+            ///          and adds the sums to the 32-bit values of the accumulation register. For int8_t, the values of
+            ///          the first register are treated as unsigned. Unlike Avx2::MultiplyAndAddAdjacent, no
+            ///          intermediate sum saturates.
+            MANTARAY_TARGET_AVX_VNNI
+            static inline Vec256I MultiplyAddAdjacentAndAccumulate(const Vec256I& ymm0, const Vec256I& ymm1,
+                                                                   const Vec256I& ymm2)
+            {
+                if (std::is_same_v<T, int8_t> ) return _mm256_dpbusd_avx_epi32(ymm0, ymm1, ymm2);
+
+                if (std::is_same_v<T, int16_t>) return _mm256_dpwssd_avx_epi32(ymm0, ymm1, ymm2);
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_AVXVNNI_H
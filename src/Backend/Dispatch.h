@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_DISPATCH_H
+#define MANTARAY_DISPATCH_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+#ifdef MANTARAY_DISPATCH
+#include <cpuid.h>
+#endif
+
+// The backends compiled into the binary. Without MANTARAY_DISPATCH, only the backend of the instruction sets enabled
+// at compile time is compiled. With MANTARAY_DISPATCH, every backend is compiled (each function for its own
+// instruction set through the target attribute), and the best backend supported by the CPU is selected at runtime.
+#ifdef MANTARAY_DISPATCH
+#define MANTARAY_AVX512_VNNI
+#define MANTARAY_AVX512
+#define MANTARAY_AVX_VNNI
+#define MANTARAY_AVX2
+#define MANTARAY_SSE
+
+#define MANTARAY_TARGET_AVX512_VNNI __attribute__((target("avx2,avx512f,avx512bw,avx512vnni")))
+#define MANTARAY_TARGET_AVX512      __attribute__((target("avx2,avx512f,avx512bw")))
+#define MANTARAY_TARGET_AVX_VNNI    __attribute__((target("avx2,avxvnni")))
+#define MANTARAY_TARGET_AVX2        __attribute__((target("avx2")))
+#define MANTARAY_TARGET_SSE         __attribute__((target("sse4.1")))
+#else
+#ifdef __AVX512BW__
+#define MANTARAY_AVX512
+
+#ifdef __AVX512VNNI__
+#define MANTARAY_AVX512_VNNI
+#endif
+#endif
+
+#ifdef __AVX2__
+#define MANTARAY_AVX2
+
+#ifdef __AVXVNNI__
+#define MANTARAY_AVX_VNNI
+#endif
+#endif
+
+#ifdef __SSE4_1__
+#define MANTARAY_SSE
+#endif
+
+#define MANTARAY_TARGET_AVX512_VNNI
+#define MANTARAY_TARGET_AVX512
+#define MANTARAY_TARGET_AVX_VNNI
+#define MANTARAY_TARGET_AVX2
+#define MANTARAY_TARGET_SSE
+#endif
+
+namespace MantaRay
+{
+
+    /// \brief The instruction sets MantaRay has a backend for, from the least to the most capable.
+    enum class InstructionSet : uint8_t
+    {
+
+        Scalar    ,
+        Sse       ,
+        Avx2      ,
+        AvxVnni   ,
+        Avx512    ,
+        Avx512Vnni
+
+    };
+
+    /// \brief A tag type selecting the backend of an instruction set.
+    /// \tparam Set The instruction set.
+    template<InstructionSet Set>
+    struct Target {};
+
+    /// \brief The tag of AVX-VNNI, which falls back to the AVX2 backend for the kernels without a VNNI
+    ///        implementation.
+    template<>
+    struct Target<InstructionSet::AvxVnni> : Target<InstructionSet::Avx2> {};
+
+    /// \brief The tag of AVX-512 VNNI, which falls back to the AVX-512 backend for the kernels without a VNNI
+    ///        implementation.
+    template<>
+    struct Target<InstructionSet::Avx512Vnni> : Target<InstructionSet::Avx512> {};
+
+    /// \brief Runtime selection of the backend.
+    /// \details With MANTARAY_DISPATCH defined, the backend is selected once at startup by querying the CPU (through
+    ///          CPUID, and XGETBV for the register state saved by the operating system), and can be changed with
+    ///          Select(). Otherwise, the backend is fixed to the instruction sets enabled at compile time, and every
+    ///          call through Invoke() resolves at compile time.
+    ///
+    ///          All weights and accumulators are aligned for the widest compiled backend, and their layout doesn't
+    ///          depend on the backend, so the backend can be changed at any time.
+    class Dispatch
+    {
+
+        public:
+#ifdef MANTARAY_DISPATCH
+        private:
+            /// \brief Checks whether the CPU and the operating system support an instruction set.
+            /// \param set The instruction set.
+            /// \return True if the instruction set is supported, false otherwise.
+            static bool Available(const InstructionSet set)
+            {
+                uint32_t eax, ebx, ecx, edx;
+
+                if (set == InstructionSet::Scalar) return true;
+
+                if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+                if (!(ecx & bit_SSE4_1) || !(ecx & bit_SSSE3)) return false;
+                if (set == InstructionSet::Sse) return true;
+
+                // AVX requires the operating system to save the register state (OSXSAVE) as well as CPU support:
+                if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) return false;
+
+                uint32_t xcr0, xcr0High;
+                asm volatile("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+
+                // The XMM and YMM state must be enabled for AVX2, and the opmask and ZMM state for AVX-512:
+                if ((xcr0 & 0x06) != 0x06) return false;
+
+                if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+                if (!(ebx & bit_AVX2)) return false;
+                if (set == InstructionSet::Avx2) return true;
+
+                if (set == InstructionSet::AvxVnni) {
+                    // AVX-VNNI is reported in the first sub-leaf:
+                    if (!__get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx)) return false;
+                    return eax & bit_AVXVNNI;
+                }
+
+                if ((xcr0 & 0xE0) != 0xE0 || !(ebx & bit_AVX512F) || !(ebx & bit_AVX512BW)) return false;
+                if (set == InstructionSet::Avx512) return true;
+
+                return ecx & bit_AVX512VNNI;
+            }
+
+        public:
+            /// \brief Detects the most capable instruction set supported by the CPU and the operating system.
+            /// \return The most capable supported instruction set.
+            static InstructionSet Detect()
+            {
+                for (const InstructionSet set : { InstructionSet::Avx512Vnni, InstructionSet::Avx512,
+                                                  InstructionSet::AvxVnni, InstructionSet::Avx2, InstructionSet::Sse })
+                    if (Available(set)) return set;
+
+                return InstructionSet::Scalar;
+            }
+#else
+            /// \brief Provides the most capable instruction set enabled at compile time.
+            /// \return The most capable instruction set enabled at compile time.
+            constexpr static InstructionSet Detect()
+            {
+#ifdef MANTARAY_AVX512_VNNI
+                return InstructionSet::Avx512Vnni;
+#elifdef MANTARAY_AVX512
+                return InstructionSet::Avx512;
+#elifdef MANTARAY_AVX_VNNI
+                return InstructionSet::AvxVnni;
+#elifdef MANTARAY_AVX2
+                return InstructionSet::Avx2;
+#elifdef MANTARAY_SSE
+                return InstructionSet::Sse;
+#else
+                return InstructionSet::Scalar;
+#endif
+            }
+#endif
+
+        private:
+#ifdef MANTARAY_DISPATCH
+            // Scalar is the zero value, so anything using the backend before the selection is initialized (such as
+            // another static initializer) safely runs the scalar backend.
+            static inline InstructionSet Current = Detect();
+#endif
+
+        public:
+            /// \brief Provides the instruction set of the selected backend.
+            /// \return The instruction set of the selected backend.
+            static inline InstructionSet Selected()
+            {
+#ifdef MANTARAY_DISPATCH
+                return Current;
+#else
+                return Detect();
+#endif
+            }
+
+            /// \brief Checks whether the backend of an instruction set can be selected.
+            /// \param set The instruction set.
+            /// \return True if the backend is compiled and supported by the CPU, false otherwise.
+            static inline bool Supported(const InstructionSet set)
+            {
+#ifdef MANTARAY_DISPATCH
+                return Available(set);
+#else
+                return set == Detect();
+#endif
+            }
+
+            /// \brief Selects the backend of an instruction set.
+            /// \param set The instruction set.
+            /// \return True if the backend was selected, false if it is not supported.
+            /// \details This is meant for benchmarking and testing the backends against each other in a single
+            ///          binary. Without MANTARAY_DISPATCH, only the backend selected at compile time is compiled.
+            static inline bool Select(const InstructionSet set)
+            {
+                if (!Supported(set)) return false;
+
+#ifdef MANTARAY_DISPATCH
+                Current = set;
+#endif
+                return true;
+            }
+
+            /// \brief Invokes a function with the target of the selected backend.
+            /// \tparam Function The type of the function.
+            /// \param function The function, taking the Target of an instruction set.
+            /// \return The result of the function.
+            /// \details Without MANTARAY_DISPATCH, the function is only instantiated (and inlined) for the backend
+            ///          selected at compile time.
+            template<typename Function>
+            static inline decltype(auto) Invoke(Function&& function)
+            {
+#ifdef MANTARAY_DISPATCH
+                switch (Current) {
+                    case InstructionSet::Avx512Vnni:
+                        return std::forward<Function>(function)(Target<InstructionSet::Avx512Vnni>());
+                    case InstructionSet::Avx512:
+                        return std::forward<Function>(function)(Target<InstructionSet::Avx512    >());
+                    case InstructionSet::AvxVnni:
+                        return std::forward<Function>(function)(Target<InstructionSet::AvxVnni   >());
+                    case InstructionSet::Avx2:
+                        return std::forward<Function>(function)(Target<InstructionSet::Avx2      >());
+                    case InstructionSet::Sse:
+                        return std::forward<Function>(function)(Target<InstructionSet::Sse       >());
+                    default:
+                        return std::forward<Function>(function)(Target<InstructionSet::Scalar    >());
+                }
+#else
+                return std::forward<Function>(function)(Target<Detect()>());
+#endif
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_DISPATCH_H
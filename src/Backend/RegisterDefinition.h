@@ -7,8 +7,9 @@
 #define MANTARAY_REGISTERDEFINITION_H
 
 #include "immintrin.h"
+#include "Dispatch.h"
 
-#ifdef __AVX512F__
+#ifdef MANTARAY_AVX512
 using Vec512I = __m512i;
 using Vec256I = __m256i;
 using Vec128I = __m128i;
@@ -0,0 +1,264 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_SSE_H
+#define MANTARAY_SSE_H
+
+#include <cstdint>
+#include <array>
+#include "RegisterDefinition.h"
+
+namespace MantaRay
+{
+
+    /// \brief SSE Intrinsics wrapper.
+    /// \tparam T Type of the data.
+    /// \details This class is a wrapper for SSE intrinsics, up to SSE4.1 (including SSSE3). It provides a common
+    ///          interface for most types of data used in MantaRay, for processors without AVX2.
+    template<typename T>
+    class Sse
+    {
+
+        static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t>,
+                      "Unsupported type provided.");
+
+        public:
+            /// \brief Load an SSE register with zeros.
+            /// \return An SSE register filled with zeros of the type T.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I Zero()
+            {
+                return _mm_setzero_si128();
+            }
+
+            /// \brief Load an SSE register with the provided value.
+            /// \param value The value to load into the register.
+            /// \return An SSE register loaded with the provided value.
+            /// \details This function loads the provided value of type T into an SSE register, duplicating the value
+            ///          across the register as necessary.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I From(const T value)
+            {
+                if (std::is_same_v<T, int8_t> ) return _mm_set1_epi8 (value);
+
+                if (std::is_same_v<T, int16_t>) return _mm_set1_epi16(value);
+
+                if (std::is_same_v<T, int32_t>) return _mm_set1_epi32(value);
+            }
+
+            /// \brief Load an SSE register from an array.
+            /// \tparam Size The size of the array.
+            /// \param array The array to load from.
+            /// \param index The index to begin loading from.
+            /// \return An SSE register loaded from the array starting at the provided index.
+            /// \details This function loads the provided array of type T into an SSE register, starting at the provided
+            ///          index. The array must have at least 16 bytes of memory allocated starting from the provided
+            ///          index.
+            template<size_t Size>
+            MANTARAY_TARGET_SSE
+            static inline Vec128I From(const std::array<T, Size>& array, const uint32_t index)
+            {
+                static_assert(sizeof(array) >= 16, "Array must be at least 16 bytes in size.");
+
+                return _mm_load_si128((Vec128I const*) &array[index]);
+            }
+
+            /// \brief Store an SSE register into an array.
+            /// \tparam Size The size of the array.
+            /// \param xmm0 The SSE register to store.
+            /// \param array The array to store into.
+            /// \param index The index to begin storing at.
+            /// \details This function stores the provided SSE register into the provided array of type T, starting at
+            ///          the provided index. The array must have at least 16 bytes of memory allocated starting from the
+            ///          provided index.
+            template<size_t Size>
+            MANTARAY_TARGET_SSE
+            static inline void Store(const Vec128I& xmm0, std::array<T, Size>& array, const uint32_t index)
+            {
+                static_assert(sizeof(array) >= 16, "Array must be at least 16 bytes in size.");
+
+                _mm_store_si128((Vec128I *) &array[index], xmm0);
+            }
+
+            /// \brief Get a register with the minimum cross-register values of the two provided registers.
+            /// \param xmm0 The first register.
+            /// \param xmm1 The second register.
+            /// \return A register with the minimum values of the two provided registers.
+            /// \details This function returns a register with the minimum values of the two provided registers. The
+            ///          minimum values are determined by comparing the values of the two registers at each index and
+            ///          storing the minimum value at that index in the returned register.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I Min(const Vec128I& xmm0, const Vec128I& xmm1)
+            {
+                if (std::is_same_v<T, int8_t> ) return _mm_min_epi8 (xmm0, xmm1);
+
+                if (std::is_same_v<T, int16_t>) return _mm_min_epi16(xmm0, xmm1);
+
+                if (std::is_same_v<T, int32_t>) return _mm_min_epi32(xmm0, xmm1);
+            }
+
+            /// \brief Get a register with the maximum cross-register values of the two provided registers.
+            /// \param xmm0 The first register.
+            /// \param xmm1 The second register.
+            /// \return A register with the maximum values of the two provided registers.
+            /// \details This function returns a register with the maximum values of the two provided registers. The
+            ///          maximum values are determined by comparing the values of the two registers at each index and
+            ///          storing the maximum value at that index in the returned register.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I Max(const Vec128I& xmm0, const Vec128I& xmm1)
+            {
+                if (std::is_same_v<T, int8_t> ) return _mm_max_epi8 (xmm0, xmm1);
+
+                if (std::is_same_v<T, int16_t>) return _mm_max_epi16(xmm0, xmm1);
+
+                if (std::is_same_v<T, int32_t>) return _mm_max_epi32(xmm0, xmm1);
+            }
+
+            /// \brief Vertically add the two provided registers.
+            /// \param xmm0 The first register.
+            /// \param xmm1 The second register.
+            /// \return A register with the sum of the two provided registers.
+            /// \details This function returns a register with the sum of the two provided registers. The sum is
+            ///          determined by adding the values of the two registers at each index and storing the sum at that
+            ///          index in the returned register.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I Add(const Vec128I& xmm0, const Vec128I& xmm1)
+            {
+                if (std::is_same_v<T, int8_t> ) return _mm_add_epi8 (xmm0, xmm1);
+
+                if (std::is_same_v<T, int16_t>) return _mm_add_epi16(xmm0, xmm1);
+
+                if (std::is_same_v<T, int32_t>) return _mm_add_epi32(xmm0, xmm1);
+            }
+
+            /// \brief Vertically subtract the two provided registers.
+            /// \param xmm0 The first register.
+            /// \param xmm1 The second register.
+            /// \return A register with the difference of the two provided registers.
+            /// \details This function returns a register with the difference of the two provided registers. The
+            ///          difference is determined by subtracting the values of the two registers at each index and
+            ///          storing the difference at that index in the returned register.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I Subtract(const Vec128I& xmm0, const Vec128I& xmm1)
+            {
+                if (std::is_same_v<T, int8_t> ) return _mm_sub_epi8 (xmm0, xmm1);
+
+                if (std::is_same_v<T, int16_t>) return _mm_sub_epi16(xmm0, xmm1);
+
+                if (std::is_same_v<T, int32_t>) return _mm_sub_epi32(xmm0, xmm1);
+            }
+
+            /// \brief Multiply the two provided registers, keeping the lower bits of the products.
+            /// \param xmm0 The first register.
+            /// \param xmm1 The second register.
+            /// \return A register with the products of the two provided registers.
+            /// \details This function returns a register with the products of the values of the two registers at each
+            ///          index. Only the lower bits of every product are kept, so the products must fit the provided
+            ///          type.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I MultiplyLow(const Vec128I& xmm0, const Vec128I& xmm1)
+            {
+                static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                return _mm_mullo_epi16(xmm0, xmm1);
+            }
+
+            /// \brief Multiply the two provided registers and add the values at adjacent indices.
+            /// \param xmm0 The first register.
+            /// \param xmm1 The second register.
+            /// \return A register with the sum of the products of the two provided registers.
+            /// \details This function returns a register with the sum of the products of the two provided registers.
+            ///          The products are determined by multiplying the values of the two registers at each index and
+            ///          then summing it up with the product of the values at the adjacent index. The returned register
+            ///          will be of a different type than the provided registers: doubling the bits of the provided
+            ///          type. For int8_t (SSSE3), the values of the first register are treated as unsigned, and the
+            ///          sums saturate to the range of int16_t.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I MultiplyAndAddAdjacent(const Vec128I& xmm0, const Vec128I& xmm1)
+            {
+                static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                if (std::is_same_v<T, int8_t> ) return _mm_maddubs_epi16(xmm0, xmm1);
+
+                if (std::is_same_v<T, int16_t>) return _mm_madd_epi16(xmm0, xmm1);
+            }
+
+            /// \brief Pack the two provided registers into a register of half the type's bits.
+            /// \param xmm0 The register holding the first half of the values.
+            /// \param xmm1 The register holding the second half of the values.
+            /// \return A register with the values of both registers, in order, saturated to half the type's bits.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I Pack(const Vec128I& xmm0, const Vec128I& xmm1)
+            {
+                static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                // A single 128-bit lane is packed, so the order is already preserved:
+                return _mm_packs_epi16(xmm0, xmm1);
+            }
+
+            /// \brief Get a mask of the non-zero values of the provided register.
+            /// \param xmm0 The register.
+            /// \return A mask with the bit of every index set if the value at that index is non-zero.
+            MANTARAY_TARGET_SSE
+            static inline uint32_t NonZeroMask(const Vec128I& xmm0)
+            {
+                static_assert(std::is_same_v<T, int32_t>, "Unsupported type provided.");
+
+                // Compare every value with zero, and invert the resulting sign-bit mask:
+                const Vec128I zero = _mm_setzero_si128();
+                return ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(xmm0, zero))) & 0xF;
+            }
+
+            /// \brief Horizontally add the values of the provided register.
+            /// \param xmm0 The register.
+            /// \return The sum of the values of the provided register.
+            /// \details This function returns the sum of the values of the provided register. The sum is determined by
+            ///          accumulating the values in the register.
+            MANTARAY_TARGET_SSE
+            static inline T Sum(const Vec128I& xmm0)
+            {
+                static_assert(std::is_same_v<T, int32_t>, "Unsupported type provided.");
+
+                // Define the register used in the horizontal addition:
+                Vec128I xmm1;
+
+                // Get the upper half of the register, and add it to the lower half vertically:
+                xmm1 = _mm_unpackhi_epi64(xmm0, xmm0);
+                xmm1 = _mm_add_epi32(xmm0, xmm1);
+
+                // Add the second-lower 32-bits to the lower 32-bits vertically:
+                xmm1 = _mm_add_epi32(xmm1, _mm_shuffle_epi32(xmm1, _MM_SHUFFLE(2, 3, 0, 1)));
+
+                // Cast the result to the 32-bit integer type and return it:
+                return _mm_cvtsi128_si32(xmm1);
+            }
+
+            /// \brief Horizontally add the values of each of the four provided registers.
+            /// \param xmm The registers.
+            /// \return A register with the sum of the values of every provided register, in order.
+            /// \details This function transposes the registers while adding them, so that the four sums are computed
+            ///          together with half as many instructions as four separate horizontal additions.
+            MANTARAY_TARGET_SSE
+            static inline Vec128I Sum(const Vec128I (&xmm)[4])
+            {
+                static_assert(std::is_same_v<T, int32_t>, "Unsupported type provided.");
+
+                // Interleave the 32-bit values of every pair of registers, and add the halves vertically, leaving the
+                // two partial sums of both registers in each register:
+                const Vec128I xmm0 = _mm_add_epi32(_mm_unpacklo_epi32(xmm[0], xmm[1]),
+                                                   _mm_unpackhi_epi32(xmm[0], xmm[1]));
+                const Vec128I xmm1 = _mm_add_epi32(_mm_unpacklo_epi32(xmm[2], xmm[3]),
+                                                   _mm_unpackhi_epi32(xmm[2], xmm[3]));
+
+                // Interleave the 64-bit values of both registers, and add the halves vertically, leaving the sum of
+                // every register in order:
+                return _mm_add_epi32(_mm_unpacklo_epi64(xmm0, xmm1), _mm_unpackhi_epi64(xmm0, xmm1));
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_SSE_H
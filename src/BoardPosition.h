@@ -0,0 +1,27 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_BOARDPOSITION_H
+#define MANTARAY_BOARDPOSITION_H
+
+#include <cstdint>
+
+namespace MantaRay
+{
+
+    /// \brief A position to evaluate from scratch, such as one of a batch of positions.
+    /// \details The pieces are stored as bitboards (bit sq set if the piece is on square sq), indexed by color and
+    ///          then piece, with the same layout as the bitboards RefreshAccumulator() takes.
+    struct BoardPosition
+    {
+
+        uint64_t Bitboards[2][6];
+        uint8_t  ColorToMove    ;
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_BOARDPOSITION_H
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_CHESS768_H
+#define MANTARAY_CHESS768_H
+
+#include <cstdint>
+
+namespace MantaRay
+{
+
+    /// \brief The plain 768 (2 colors x 6 pieces x 64 squares) input feature set.
+    /// \details Calling the static Index function will provide the index of a piece on a square with respect to a
+    ///          perspective. The board is flipped vertically for black's perspective, and the colors are swapped so
+    ///          that each perspective sees its own pieces first. The index does not depend on the king square, so
+    ///          the accumulator never has to be refreshed.
+    class Chess768
+    {
+
+        private:
+            constexpr static uint16_t ColorStride = 64 * 6;
+            constexpr static uint8_t  PieceStride = 64    ;
+
+        public:
+            /// \brief The number of input features.
+            constexpr static uint16_t InputSize = 768;
+
+            /// \brief Whether feature indices depend on the king squares.
+            constexpr static bool KingRelative = false;
+
+            /// \brief The number of distinct feature mappings a perspective can be in.
+            constexpr static uint8_t RefreshBuckets = 1;
+
+            /// \brief Calculates the index of a feature with respect to a perspective.
+            /// \param perspective The perspective (0 for white, 1 for black).
+            /// \param piece The piece.
+            /// \param color The color of the piece.
+            /// \param sq The square of the piece.
+            /// \return The index of the feature in the input layer.
+            static inline uint32_t Index(const uint8_t perspective, const uint8_t piece, const uint8_t color,
+                                         const uint8_t sq, const uint8_t)
+            {
+                return (color ^ perspective) * ColorStride + piece * PieceStride + (sq ^ (perspective * 56));
+            }
+
+            /// \brief Calculates the feature mapping a perspective is in.
+            /// \return Always 0, as the feature indices do not depend on the king square.
+            static inline uint8_t RefreshBucket(const uint8_t, const uint8_t)
+            {
+                return 0;
+            }
+
+            /// \brief Whether a king move requires the accumulator to be refreshed for a perspective.
+            /// \return Always false, as the feature indices do not depend on the king square.
+            static inline bool RequiresRefresh(const uint8_t, const uint8_t, const uint8_t)
+            {
+                return false;
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_CHESS768_H
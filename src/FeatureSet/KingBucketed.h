@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_KINGBUCKETED_H
+#define MANTARAY_KINGBUCKETED_H
+
+#include <array>
+#include <cstdint>
+
+namespace MantaRay
+{
+
+    /// \brief The king-bucketed (HalfKA-style) input feature set.
+    /// \tparam Layout The bucket of every king square, as seen from the perspective's own side of the board.
+    /// \tparam HorizontallyMirrored Whether to mirror the board horizontally when the king is on the e-h files.
+    /// \details Every bucket holds a full set of 768 (2 colors x 6 pieces x 64 squares) features, and the bucket used
+    ///          by a perspective is chosen by the square of that perspective's own king. The board is flipped
+    ///          vertically for black's perspective, and, when mirrored, flipped horizontally whenever the king is on
+    ///          the right half of the board (so only the left half of the layout is ever used).
+    ///
+    ///          Since the indices depend on the king square, a king move that changes the bucket (or the mirroring)
+    ///          of its perspective requires that perspective to be refreshed.
+    template<std::array<uint8_t, 64> Layout, bool HorizontallyMirrored = false>
+    class KingBucketed
+    {
+
+        private:
+            constexpr static uint16_t BucketStride = 64 * 6 * 2;
+            constexpr static uint16_t ColorStride  = 64 * 6    ;
+            constexpr static uint8_t  PieceStride  = 64        ;
+
+            /// \brief Calculates the number of buckets in the layout.
+            constexpr static uint8_t CountBuckets()
+            {
+                uint8_t count = 0;
+                for (const uint8_t bucket : Layout) if (bucket >= count) count = bucket + 1;
+                return count;
+            }
+
+            /// \brief Calculates the horizontal flip for a perspective's king square.
+            static inline uint8_t Flip(const uint8_t relativeKing)
+            {
+                return HorizontallyMirrored && (relativeKing & 7) >= 4 ? 7 : 0;
+            }
+
+        public:
+            /// \brief The number of king buckets.
+            constexpr static uint8_t BucketCount = CountBuckets();
+
+            /// \brief The number of input features.
+            constexpr static uint16_t InputSize = BucketCount * BucketStride;
+
+            /// \brief Whether feature indices depend on the king squares.
+            constexpr static bool KingRelative = true;
+
+            /// \brief The number of distinct feature mappings a perspective can be in (every bucket, once per
+            ///        mirroring).
+            constexpr static uint8_t RefreshBuckets = BucketCount * (HorizontallyMirrored ? 2 : 1);
+
+            /// \brief Calculates the index of a feature with respect to a perspective.
+            /// \param perspective The perspective (0 for white, 1 for black).
+            /// \param piece The piece.
+            /// \param color The color of the piece.
+            /// \param sq The square of the piece.
+            /// \param king The square of the perspective's own king.
+            /// \return The index of the feature in the input layer.
+            static inline uint32_t Index(const uint8_t perspective, const uint8_t piece, const uint8_t color,
+                                         const uint8_t sq, const uint8_t king)
+            {
+                const uint8_t relativeKing = king ^ (perspective * 56);
+                const uint8_t flip         = Flip(relativeKing);
+
+                return Layout[relativeKing ^ flip] * BucketStride + (color ^ perspective) * ColorStride +
+                       piece * PieceStride + (sq ^ (perspective * 56) ^ flip);
+            }
+
+            /// \brief Calculates the feature mapping a perspective is in.
+            /// \param perspective The perspective (0 for white, 1 for black).
+            /// \param king The square of the perspective's own king.
+            /// \return The bucket and mirroring of the perspective, combined into a value below RefreshBuckets.
+            static inline uint8_t RefreshBucket(const uint8_t perspective, const uint8_t king)
+            {
+                const uint8_t relativeKing = king ^ (perspective * 56);
+                const uint8_t flip         = Flip(relativeKing);
+
+                if constexpr (HorizontallyMirrored) return Layout[relativeKing ^ flip] * 2 + (flip != 0);
+                else return Layout[relativeKing];
+            }
+
+            /// \brief Whether a king move requires the accumulator to be refreshed for a perspective.
+            /// \param perspective The perspective (and color) of the king that is moved.
+            /// \param from The square the king is moved from.
+            /// \param to The square the king is moved to.
+            /// \return True if the move changes the bucket or mirroring of the perspective.
+            static inline bool RequiresRefresh(const uint8_t perspective, const uint8_t from, const uint8_t to)
+            {
+                return RefreshBucket(perspective, from) != RefreshBucket(perspective, to);
+            }
+
+    };
+
+    /// \brief The plain 768 input feature set, horizontally mirrored so that the king is always on the a-d files.
+    using Mirrored768 = KingBucketed<std::array<uint8_t, 64> {}, true>;
+
+} // MantaRay
+
+#endif //MANTARAY_KINGBUCKETED_H
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_AFFINELAYER_H
+#define MANTARAY_AFFINELAYER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "../SIMD.h"
+#include "../IO/BinaryFileStream.h"
+#include "../IO/BinaryMemoryStream.h"
+#include "../IO/MarlinflowStream.h"
+
+namespace MantaRay
+{
+
+    /// \brief An affine (fully connected) layer with 8-bit weights.
+    /// \tparam InputSize The size of the input of the layer.
+    /// \tparam OutputSize The size of the output of the layer.
+    /// \details The layer computes output = input * weight + bias, with 8-bit (unsigned) inputs, 8-bit weights and
+    ///          32-bit biases and outputs. The weights of every output are stored contiguously, and padded to a
+    ///          multiple of the widest register so that every output can be computed with whole registers. The
+    ///          padding of the weights is zero, and the padding of the input must be zero as well.
+    template<uint16_t InputSize, uint16_t OutputSize>
+    class AffineLayer
+    {
+
+        public:
+            constexpr static uint16_t Inputs       = InputSize ;
+            constexpr static uint16_t Outputs      = OutputSize;
+            constexpr static uint16_t PaddedInputs = (InputSize + 63) / 64 * 64;
+
+#ifdef MANTARAY_AVX512
+            alignas(64) std::array<int8_t , PaddedInputs * OutputSize> Weight;
+            alignas(64) std::array<int32_t, OutputSize               > Bias  ;
+#elifdef MANTARAY_AVX2
+            alignas(32) std::array<int8_t , PaddedInputs * OutputSize> Weight;
+            alignas(32) std::array<int32_t, OutputSize               > Bias  ;
+#elifdef MANTARAY_SSE
+            alignas(16) std::array<int8_t , PaddedInputs * OutputSize> Weight;
+            alignas(16) std::array<int32_t, OutputSize               > Bias  ;
+#else
+            std::array<int8_t , PaddedInputs * OutputSize> Weight;
+            std::array<int32_t, OutputSize               > Bias  ;
+#endif
+
+            /// \brief Reads the layer from a binary stream.
+            /// \tparam Stream The type of the binary stream (file or memory).
+            /// \param stream The binary stream to read the layer from.
+            /// \details The weights are read in their padded layout, as written by WriteTo().
+            template<typename Stream>
+            void ReadFrom(Stream& stream)
+            {
+                stream.ReadArray(Weight);
+                stream.ReadArray(Bias  );
+            }
+
+            /// \brief Reads the layer from a Marlinflow JSON stream.
+            /// \param stream The Marlinflow JSON stream to read the layer from.
+            /// \param key The key of the layer (the weights and biases are read from key.weight and key.bias).
+            /// \param quantizationInput The quantization factor of the input of the layer.
+            /// \param quantizationWeight The quantization factor of the weights of the layer.
+            /// \details The weights are quantized by the weight quantization factor, and the biases by the product of
+            ///          both quantization factors (the quantization of the output of the layer).
+            void ReadFrom(MarlinflowStream& stream, const std::string& key, const size_t quantizationInput,
+                          const size_t quantizationWeight)
+            {
+                Weight.fill(0);
+
+                stream.Read2DArray(key + ".weight", Weight, PaddedInputs, quantizationWeight, false);
+                stream.ReadArray  (key + ".bias"  , Bias  , quantizationInput * quantizationWeight);
+            }
+
+            /// \brief Writes the layer to a binary file stream.
+            /// \param stream The binary file stream to write the layer to.
+            void WriteTo(BinaryFileStream& stream) const
+            {
+                stream.WriteArray(Weight);
+                stream.WriteArray(Bias  );
+            }
+
+            /// \brief Forward propagates an input through the layer.
+            /// \param input The (padded) input of the layer.
+            /// \param output The output of the layer.
+            inline void Forward(const std::array<int8_t, PaddedInputs>& input,
+                                std::array<int32_t, OutputSize>& output) const
+            {
+                SIMD::Forward<PaddedInputs, OutputSize>(input, Weight, Bias, output);
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_AFFINELAYER_H
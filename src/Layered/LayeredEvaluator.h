@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_LAYEREDEVALUATOR_H
+#define MANTARAY_LAYEREDEVALUATOR_H
+
+#include <array>
+#include <cstdint>
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+
+#include "LayeredWeights.h"
+#include "../Perspective/PerspectiveAccumulator.h"
+#include "../Perspective/PerspectiveFeatureTransformer.h"
+#include "../SIMD.h"
+
+namespace MantaRay
+{
+
+    /// \brief The per-thread state of a Layered Neural Network.
+    /// \tparam Activation The activation function of the feature transformer.
+    /// \tparam HiddenActivation The activation function between the affine layers.
+    /// \tparam InputSize The size of the input layer.
+    /// \tparam HiddenSize The size of the hidden layer (the size of a single perspective's accumulator).
+    /// \tparam AccumulatorStackSize The size of the accumulator stack.
+    /// \tparam Scale The scale factor of the network.
+    /// \tparam QuantizationFeature The quantization factor of the feature transformer.
+    /// \tparam QuantizationHidden The quantization factor of the weights of the affine layers.
+    /// \tparam FeatureSet The input feature set, which maps pieces on squares to input layer indices.
+    /// \tparam LayerSizes The output sizes of the affine layers following the feature transformer, in order.
+    /// \details This class owns the accumulator stack of a layered neural network, and references (but never
+    ///          modifies) a shared set of weights. The accumulator stack is kept up to date exactly like the one of a
+    ///          MantaRay::PerspectiveEvaluator.
+    ///
+    ///          The activation of the feature transformer must clip the accumulator to [0, QuantizationFeature]
+    ///          (such as ClippedReLU<int16_t, 0, QuantizationFeature>), and the activation between the affine layers
+    ///          must keep its output within [0, QuantizationFeature] (such as ClippedReLU<int32_t, 0,
+    ///          QuantizationFeature> or SCReLU<int32_t, 0, QuantizationFeature>), so that every activation fits the
+    ///          8-bit input of the next layer.
+    /// \see MantaRay::LayeredWeights for the shared weights.
+    /// \see MantaRay::LayeredNetwork for a network that owns both its weights and its evaluation state.
+    template<typename Activation, typename HiddenActivation, uint16_t InputSize, uint16_t HiddenSize,
+            uint16_t AccumulatorStackSize, int16_t Scale, int16_t QuantizationFeature, int16_t QuantizationHidden,
+            typename FeatureSet, uint16_t... LayerSizes>
+    class LayeredEvaluator : public PerspectiveFeatureTransformer<int16_t, InputSize, HiddenSize, AccumulatorStackSize,
+                                                                  FeatureSet>
+    {
+
+        // The scale should make sense. Change this later if requested.
+        static_assert(Scale > 0, "This scale constant doesn't seem right.");
+
+        // The activated accumulator is packed as is, so the feature transformer's activation can't rescale it.
+        static_assert(Activation::Divisor == 1, "The feature transformer activation must only clip its input.");
+
+        public:
+            using Weights = LayeredWeights<InputSize, HiddenSize, QuantizationFeature, QuantizationHidden, FeatureSet,
+                    LayerSizes...>;
+
+            using Transformer = PerspectiveFeatureTransformer<int16_t, InputSize, HiddenSize, AccumulatorStackSize,
+                    FeatureSet>;
+
+        private:
+            constexpr static size_t LayerCount = sizeof...(LayerSizes);
+
+            template<size_t Index>
+            using Layer = std::tuple_element_t<Index, typename Weights::LayerStack>;
+
+            const Weights& Parameters;
+
+            /// \brief Forward propagates an input through an affine layer and every layer after it.
+            /// \tparam Index The index of the affine layer.
+            /// \param input The (padded) input of the affine layer.
+            /// \return The output of the last affine layer.
+            /// \details The output of every layer but the last is scaled back down to the quantization of the feature
+            ///          transformer and activated, forming the input of the next layer.
+            template<size_t Index>
+            inline int32_t Propagate(const std::array<int8_t, Layer<Index>::PaddedInputs>& input) const
+            {
+#ifdef MANTARAY_AVX512
+                alignas(64) std::array<int32_t, Layer<Index>::Outputs> output;
+#elifdef MANTARAY_AVX2
+                alignas(32) std::array<int32_t, Layer<Index>::Outputs> output;
+#elifdef MANTARAY_SSE
+                alignas(16) std::array<int32_t, Layer<Index>::Outputs> output;
+#else
+                std::array<int32_t, Layer<Index>::Outputs> output;
+#endif
+
+                std::get<Index>(Parameters.Layers).Forward(input, output);
+
+                if constexpr (Index + 1 == LayerCount) return output[0];
+                else {
+#ifdef MANTARAY_AVX512
+                    alignas(64) std::array<int8_t, Layer<Index + 1>::PaddedInputs> activated;
+#elifdef MANTARAY_AVX2
+                    alignas(32) std::array<int8_t, Layer<Index + 1>::PaddedInputs> activated;
+#elifdef MANTARAY_SSE
+                    alignas(16) std::array<int8_t, Layer<Index + 1>::PaddedInputs> activated;
+#else
+                    std::array<int8_t, Layer<Index + 1>::PaddedInputs> activated;
+#endif
+
+                    // Activate the output, and zero the padding of the next layer's input:
+                    for (size_t i = 0; i < Layer<Index>::Outputs; i++)
+                        activated[i] = static_cast<int8_t>(HiddenActivation::Apply(output[i] / QuantizationHidden));
+
+                    std::fill(std::begin(activated) + Layer<Index>::Outputs, std::end(activated), 0);
+
+                    return Propagate<Index + 1>(activated);
+                }
+            }
+
+        public:
+            /// \brief Constructs a new LayeredEvaluator.
+            /// \tparam W The type of the weights, which may be any type deriving from the weights (such as a
+            ///           LayeredNetwork).
+            /// \param weights The weights to evaluate with.
+            /// \details This constructor initializes the accumulator stack. The weights are referenced, not copied,
+            ///          and must outlive the evaluator.
+            template<typename W> requires std::is_base_of_v<Weights, W>
+            __attribute__((unused)) explicit LayeredEvaluator(const W& weights) :
+            Transformer(weights.FeatureWeight, weights.FeatureBias), Parameters(weights) {}
+
+            /// \brief Constructs a new LayeredEvaluator.
+            /// \param weights The weights to evaluate with.
+            /// \param other The evaluator to copy the evaluation state from.
+            /// \details This constructor copies the accumulator stack of another evaluator, but references the given
+            ///          weights instead of the other evaluator's weights.
+            __attribute__((unused)) LayeredEvaluator(const Weights& weights, const LayeredEvaluator& other) :
+            Transformer(weights.FeatureWeight, weights.FeatureBias, other), Parameters(weights) {}
+
+            LayeredEvaluator(const LayeredEvaluator&) = default;
+
+            /// \brief Copies the evaluation state of another evaluator.
+            /// \param other The evaluator to copy the evaluation state from.
+            /// \return This evaluator.
+            /// \details The accumulator stack is copied, while this evaluator keeps referencing its own weights.
+            LayeredEvaluator& operator=(const LayeredEvaluator& other)
+            {
+                Transformer::operator=(other);
+                return *this;
+            }
+
+            /// \brief Evaluates the network with respect to the current accumulator.
+            /// \param colorToMove The color to move.
+            /// \return The evaluation of the network with respect to the current accumulator.
+            /// \details The accumulator of the color to move and the accumulator of the other color are activated and
+            ///          packed into 8-bit values, which are then forward propagated through every affine layer.
+            __attribute__((unused)) inline int32_t Evaluate(const uint8_t colorToMove)
+            {
+                // Fetch the current accumulator, applying any lazily recorded changes:
+                const PerspectiveAccumulator<int16_t, HiddenSize>& accumulator = this->ComputedAccumulator();
+
+#ifdef MANTARAY_AVX512
+                alignas(64) std::array<int8_t, HiddenSize * 2> transformed;
+#elifdef MANTARAY_AVX2
+                alignas(32) std::array<int8_t, HiddenSize * 2> transformed;
+#elifdef MANTARAY_SSE
+                alignas(16) std::array<int8_t, HiddenSize * 2> transformed;
+#else
+                std::array<int8_t, HiddenSize * 2> transformed;
+#endif
+
+                // Activate and pack the accumulator, with the perspective of the color to move first:
+                SIMD::ActivateAndPack<Activation>(colorToMove == 0 ? accumulator.White : accumulator.Black,
+                                                  transformed, 0);
+                SIMD::ActivateAndPack<Activation>(colorToMove == 0 ? accumulator.Black : accumulator.White,
+                                                  transformed, HiddenSize);
+
+                // Forward propagate through the affine layers, and scale the output with respect to the quantization:
+                return Propagate<0>(transformed) * Scale / (QuantizationFeature * QuantizationHidden);
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_LAYEREDEVALUATOR_H
@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_LAYEREDNNUE_H
+#define MANTARAY_LAYEREDNNUE_H
+
+#include <array>
+#include <cstdint>
+#include <sstream>
+
+#include "LayeredWeights.h"
+#include "LayeredEvaluator.h"
+#include "../FeatureSet/Chess768.h"
+#include "../FeatureSet/KingBucketed.h"
+
+namespace MantaRay
+{
+
+    /// \brief A Layered Neural Network.
+    /// \tparam Activation The activation function of the feature transformer.
+    /// \tparam HiddenActivation The activation function between the affine layers.
+    /// \tparam InputSize The size of the input layer.
+    /// \tparam HiddenSize The size of the hidden layer (the size of a single perspective's accumulator).
+    /// \tparam AccumulatorStackSize The size of the accumulator stack.
+    /// \tparam Scale The scale factor of the network.
+    /// \tparam QuantizationFeature The quantization factor of the feature transformer.
+    /// \tparam QuantizationHidden The quantization factor of the weights of the affine layers.
+    /// \tparam FeatureSet The input feature set.
+    /// \tparam LayerSizes The output sizes of the affine layers following the feature transformer, in order.
+    /// \details This class implements a perspective-accounting neural network with any number of affine layers
+    ///          following the feature transformer.
+    ///
+    ///          The architecture is as follows: Concat((InputLayer -> Activation -> HiddenLayer)x2, CTM) ->
+    ///          (AffineLayer -> HiddenActivation)xN -> AffineLayer, where CTM is the Color To Move. The feature
+    ///          transformer is 16-bit, while the affine layers have 8-bit weights and 8-bit activations.
+    ///
+    ///          The network owns both its weights and a single evaluator over them. When multiple threads need to
+    ///          evaluate with the same network, load the weights once as a LayeredNetwork::Weights and create one
+    ///          LayeredNetwork::Evaluator per thread instead.
+    template<typename Activation, typename HiddenActivation, uint16_t InputSize, uint16_t HiddenSize,
+            uint16_t AccumulatorStackSize, int16_t Scale, int16_t QuantizationFeature, int16_t QuantizationHidden,
+            typename FeatureSet, uint16_t... LayerSizes>
+    class LayeredNetwork : public LayeredWeights<InputSize, HiddenSize, QuantizationFeature, QuantizationHidden,
+                                                 FeatureSet, LayerSizes...>,
+                           public LayeredEvaluator<Activation, HiddenActivation, InputSize, HiddenSize,
+                                                   AccumulatorStackSize, Scale, QuantizationFeature,
+                                                   QuantizationHidden, FeatureSet, LayerSizes...>
+    {
+
+        public:
+            using Weights   = LayeredWeights<InputSize, HiddenSize, QuantizationFeature, QuantizationHidden,
+                    FeatureSet, LayerSizes...>;
+            using Evaluator = LayeredEvaluator<Activation, HiddenActivation, InputSize, HiddenSize,
+                    AccumulatorStackSize, Scale, QuantizationFeature, QuantizationHidden, FeatureSet, LayerSizes...>;
+
+            /// \brief Constructs a new LayeredNetwork.
+            /// \details This constructor initializes the network with undefined weights and biases.
+            __attribute__((unused)) LayeredNetwork() :
+            Weights(), Evaluator(static_cast<const Weights&>(*this)) {}
+
+            /// \brief Constructs a new LayeredNetwork.
+            /// \param stream The binary file stream to read the network from.
+            /// \details This constructor initializes the network with the weights and biases read from the stream.
+            __attribute__((unused)) explicit LayeredNetwork(BinaryFileStream &stream) :
+            Weights(stream), Evaluator(static_cast<const Weights&>(*this)) {}
+
+            /// \brief Constructs a new LayeredNetwork.
+            /// \param stream The binary memory stream to read the network from.
+            /// \details This constructor initializes the network with the weights and biases read from the stream.
+            __attribute__((unused)) explicit LayeredNetwork(BinaryMemoryStream &stream) :
+            Weights(stream), Evaluator(static_cast<const Weights&>(*this)) {}
+
+            /// \brief Constructs a new LayeredNetwork.
+            /// \param stream The Marlinflow JSON stream to read the network from.
+            /// \details This constructor initializes the network with the weights and biases read from the stream,
+            ///          quantizing them and permuting the feature weights.
+            __attribute__((unused)) explicit LayeredNetwork(MarlinflowStream &stream) :
+            Weights(stream), Evaluator(static_cast<const Weights&>(*this)) {}
+
+            /// \brief Constructs a new LayeredNetwork.
+            /// \param other The network to copy.
+            /// \details This constructor copies both the weights and the evaluation state of the other network. The
+            ///          copied evaluation state references the copied weights, not the other network's weights.
+            __attribute__((unused)) LayeredNetwork(const LayeredNetwork& other) :
+            Weights(other), Evaluator(static_cast<const Weights&>(*this), other) {}
+
+            LayeredNetwork& operator=(const LayeredNetwork&) = default;
+
+            /// \brief Provides information about the network.
+            /// \return A string containing information about the network.
+            /// \details This function provides information about the network, such as the layer sizes and the
+            ///          quantization constants, as well as other properties used at runtime such as the accumulator
+            ///          stack size and the scale.
+            __attribute__((unused)) std::string Info() const
+            {
+                std::stringstream ss;
+                ss << Weights::Info();
+                ss << " | " << "AccumulatorStackSize : " << AccumulatorStackSize        << std::endl;
+                ss << " | " << "Scale                : " << Scale                       << std::endl;
+                return ss.str();
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_LAYEREDNNUE_H
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_LAYEREDWEIGHTS_H
+#define MANTARAY_LAYEREDWEIGHTS_H
+
+#include <array>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "AffineLayer.h"
+#include "SparseAffineLayer.h"
+#include "../IO/BinaryFileStream.h"
+#include "../IO/BinaryMemoryStream.h"
+#include "../IO/MarlinflowStream.h"
+
+namespace MantaRay
+{
+
+    /// \brief The affine layers of a Layered Neural Network.
+    /// \tparam InputSize The size of the input of the first layer.
+    /// \tparam LayerSizes The output sizes of the layers, in order.
+    /// \details Type is a tuple of affine layers, where the input of every layer is the output of the layer before
+    ///          it.
+    template<uint16_t InputSize, uint16_t... LayerSizes>
+    struct AffineLayers
+    {
+
+        using Type = std::tuple<>;
+
+    };
+
+    template<uint16_t InputSize, uint16_t LayerSize, uint16_t... LayerSizes>
+    struct AffineLayers<InputSize, LayerSize, LayerSizes...>
+    {
+
+        using Type = decltype(std::tuple_cat(
+                std::declval<std::tuple<AffineLayer<InputSize, LayerSize>>>(),
+                std::declval<typename AffineLayers<LayerSize, LayerSizes...>::Type>()));
+
+    };
+
+    /// \brief The affine layers of a Layered Neural Network, starting with a layer over sparse inputs.
+    /// \tparam InputSize The size of the input of the first layer.
+    /// \tparam LayerSize The output size of the first layer.
+    /// \tparam LayerSizes The output sizes of the layers after the first layer, in order.
+    /// \details Like MantaRay::AffineLayers, but the first layer skips the zero chunks of its input, if its output
+    ///          size allows it.
+    template<uint16_t InputSize, uint16_t LayerSize, uint16_t... LayerSizes>
+    struct SparseAffineLayers
+    {
+
+        using InputLayer = std::conditional_t<LayerSize % 16 == 0,
+                SparseAffineLayer<InputSize, LayerSize>, AffineLayer<InputSize, LayerSize>>;
+
+        using Type = decltype(std::tuple_cat(
+                std::declval<std::tuple<InputLayer>>(),
+                std::declval<typename AffineLayers<LayerSize, LayerSizes...>::Type>()));
+
+    };
+
+    /// \brief The weights and biases of a Layered Neural Network.
+    /// \tparam InputSize The size of the input layer.
+    /// \tparam HiddenSize The size of the hidden layer (the size of a single perspective's accumulator).
+    /// \tparam QuantizationFeature The quantization factor of the feature transformer.
+    /// \tparam QuantizationHidden The quantization factor of the weights of the affine layers.
+    /// \tparam FeatureSet The input feature set the weights were trained with.
+    /// \tparam LayerSizes The output sizes of the affine layers following the feature transformer, in order.
+    /// \details This class holds the 16-bit weights and biases of the feature transformer, and the 8-bit weights and
+    ///          32-bit biases of every affine layer. Like MantaRay::PerspectiveWeights, it is never written to during
+    ///          inference, so a single instance can be shared by any number of evaluators.
+    ///
+    ///          If the output size of the first affine layer is a multiple of 16, the first affine layer is a
+    ///          MantaRay::SparseAffineLayer, which only multiplies the non-zero chunks of the activated accumulator.
+    ///
+    ///          The activations between layers are 8-bit values at the quantization of the feature transformer, so
+    ///          the quantization factor of the feature transformer can't exceed 127. The output of every affine layer
+    ///          is at the quantization of its input multiplied by QuantizationHidden.
+    /// \see MantaRay::LayeredEvaluator for the per-thread state that references these weights.
+    template<uint16_t InputSize, uint16_t HiddenSize, int16_t QuantizationFeature, int16_t QuantizationHidden,
+            typename FeatureSet, uint16_t... LayerSizes>
+    class LayeredWeights
+    {
+
+        // The input layer must be the size of the feature set.
+        static_assert(InputSize == FeatureSet::InputSize, "The input size does not match the feature set.");
+
+        // The activated accumulator is packed in steps of two of the widest registers.
+        static_assert(HiddenSize >= 64 && HiddenSize % 64 == 0, "This network size is currently not supported.");
+
+        // The activations must fit 8 bits, and the products of the activations and the weights must fit 16 bits.
+        static_assert(QuantizationFeature > 0 && QuantizationFeature <= 127 &&
+                      QuantizationHidden  > 0 && QuantizationHidden  <= 127,
+                "These quantization constants don't seem right.");
+
+        // The network must end in a single output.
+        static_assert(std::array<uint16_t, sizeof...(LayerSizes)> { LayerSizes... }.back() == 1,
+                "The last layer must have a single output.");
+
+        public:
+            using LayerStack = typename SparseAffineLayers<HiddenSize * 2, LayerSizes...>::Type;
+
+#ifdef MANTARAY_AVX512
+            alignas(64) std::array<int16_t, InputSize * HiddenSize> FeatureWeight;
+            alignas(64) std::array<int16_t, HiddenSize            > FeatureBias  ;
+#elifdef MANTARAY_AVX2
+            alignas(32) std::array<int16_t, InputSize * HiddenSize> FeatureWeight;
+            alignas(32) std::array<int16_t, HiddenSize            > FeatureBias  ;
+#elifdef MANTARAY_SSE
+            alignas(16) std::array<int16_t, InputSize * HiddenSize> FeatureWeight;
+            alignas(16) std::array<int16_t, HiddenSize            > FeatureBias  ;
+#else
+            std::array<int16_t, InputSize * HiddenSize> FeatureWeight;
+            std::array<int16_t, HiddenSize            > FeatureBias  ;
+#endif
+
+            LayerStack Layers;
+
+            /// \brief Constructs a new LayeredWeights.
+            /// \details This constructor leaves the weights and biases undefined.
+            __attribute__((unused)) LayeredWeights() = default;
+
+            /// \brief Constructs a new LayeredWeights.
+            /// \param stream The binary file stream to read the weights from.
+            /// \details This constructor initializes the weights and biases read from the stream.
+            __attribute__((unused)) explicit LayeredWeights(BinaryFileStream &stream)
+            {
+                stream.ReadArray(FeatureWeight);
+                stream.ReadArray(FeatureBias  );
+
+                std::apply([&](auto&... layer) { (layer.ReadFrom(stream), ...); }, Layers);
+            }
+
+            /// \brief Constructs a new LayeredWeights.
+            /// \param stream The binary memory stream to read the weights from.
+            /// \details This constructor initializes the weights and biases read from the stream.
+            __attribute__((unused)) explicit LayeredWeights(BinaryMemoryStream &stream)
+            {
+                stream.ReadArray(FeatureWeight);
+                stream.ReadArray(FeatureBias  );
+
+                std::apply([&](auto&... layer) { (layer.ReadFrom(stream), ...); }, Layers);
+            }
+
+            /// \brief Constructs a new LayeredWeights.
+            /// \param stream The Marlinflow JSON stream to read the weights from.
+            /// \details This constructor initializes the weights and biases read from the stream, quantizing them and
+            ///          permuting the feature weights like MantaRay::PerspectiveWeights. The feature transformer is
+            ///          read from "ft", and the affine layers from "l1", "l2", and so on.
+            __attribute__((unused)) explicit LayeredWeights(MarlinflowStream &stream)
+            {
+                stream.Read2DArray("ft.weight", FeatureWeight, HiddenSize, QuantizationFeature, true);
+                stream.ReadArray  ("ft.bias"  , FeatureBias  ,             QuantizationFeature      );
+
+                size_t index = 1;
+                std::apply([&](auto&... layer) {
+                    (layer.ReadFrom(stream, "l" + std::to_string(index++), QuantizationFeature, QuantizationHidden),
+                     ...);
+                }, Layers);
+            }
+
+            /// \brief Provides information about the weights.
+            /// \return A string containing information about the weights.
+            /// \details This function provides information about the architecture the weights belong to, such as the
+            ///          layer sizes, the number of weights and biases, and the quantization constants.
+            __attribute__((unused)) std::string Info() const
+            {
+                std::stringstream ss;
+                ss << "(" << InputSize << "->" << HiddenSize << ")" << "x2";
+                ((ss << "->" << LayerSizes), ...);
+                ss << std::endl;
+
+                ss << "Details:" << std::endl;
+                ss << " | " << "First  Layer Size    : " << InputSize                   << std::endl;
+                ss << " | " << "Hidden Layer Size    : " << HiddenSize                  << std::endl;
+                ss << " | " << "Affine Layer Count   : " << sizeof...(LayerSizes)       << std::endl;
+                ss << " | " << "Input ->Hidden Weight: " <<  InputSize *     HiddenSize << std::endl;
+                ss << " | " << "QuantizationFeature  : " << QuantizationFeature         << std::endl;
+                ss << " | " << "QuantizationHidden   : " << QuantizationHidden          << std::endl;
+                return ss.str();
+            }
+
+            /// \brief Writes the weights to a binary file stream.
+            /// \param stream The binary file stream to write the weights to.
+            /// \details This function writes the weights and biases to the stream.
+            __attribute__((unused)) void WriteTo(BinaryFileStream &stream) const
+            {
+                stream.WriteMode();
+
+                stream.WriteArray(FeatureWeight);
+                stream.WriteArray(FeatureBias  );
+
+                std::apply([&](const auto&... layer) { (layer.WriteTo(stream), ...); }, Layers);
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_LAYEREDWEIGHTS_H
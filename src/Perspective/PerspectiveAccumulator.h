@@ -7,13 +7,22 @@
 #define MANTARAY_PERSPECTIVEACCUMULATOR_H
 
 #include <array>
+#include <algorithm>
 
-#ifdef __AVX512BW__
+#include "../Backend/Dispatch.h"
+
+#ifdef MANTARAY_AVX512
 #include "../Backend/Avx512.h"
-#elifdef __AVX2__
+#endif
+
+#ifdef MANTARAY_AVX2
 #include "../Backend/Avx2.h"
 #endif
 
+#ifdef MANTARAY_SSE
+#include "../Backend/Sse.h"
+#endif
+
 namespace MantaRay
 {
 
@@ -31,12 +40,15 @@ namespace MantaRay
     {
 
         public:
-#ifdef __AVX512BW__
+#ifdef MANTARAY_AVX512
             alignas(64) std::array<T, AccumulatorSize> White;
             alignas(64) std::array<T, AccumulatorSize> Black;
-#elifdef __AVX2__
+#elifdef MANTARAY_AVX2
             alignas(32) std::array<T, AccumulatorSize> White;
             alignas(32) std::array<T, AccumulatorSize> Black;
+#elifdef MANTARAY_SSE
+            alignas(16) std::array<T, AccumulatorSize> White;
+            alignas(16) std::array<T, AccumulatorSize> Black;
 #else
             std::array<T, AccumulatorSize> White;
             std::array<T, AccumulatorSize> Black;
@@ -53,12 +65,19 @@ namespace MantaRay
             /// \param accumulator The accumulator to copy to.
             /// \details Copies the contents of this accumulator to the provided accumulator. Uses SIMD instructions
             ///          where beneficial.
-            inline void CopyTo(PerspectiveAccumulator<T, AccumulatorSize>& accumulator)
+            inline void CopyTo(PerspectiveAccumulator<T, AccumulatorSize>& accumulator) const
             {
                 // Certain instructions can be limited further down, but due to alignment issues, performance may not be
                 // best. Thus, currently limiting to peak instruction set.
+                Dispatch::Invoke([&](auto target) { CopyTo(target, accumulator); });
+            }
 
-#ifdef __AVX512BW__ // Limit this to AVX512F instead.
+#ifdef MANTARAY_AVX512
+            /// \brief The AVX-512 implementation of CopyTo().
+            MANTARAY_TARGET_AVX512
+            inline void CopyTo(Target<InstructionSet::Avx512>,
+                               PerspectiveAccumulator<T, AccumulatorSize>& accumulator) const
+            {
                 // Define the register:
                 Vec512I zmm0;
 
@@ -84,7 +103,15 @@ namespace MantaRay
                     Avx512<T>::Store(zmm0, accumulator.Black, i);
                 }
                 //endregion
-#elifdef __AVX2__ // Limit this to AVX instead.
+            }
+#endif
+
+#ifdef MANTARAY_AVX2
+            /// \brief The AVX2 implementation of CopyTo().
+            MANTARAY_TARGET_AVX2
+            inline void CopyTo(Target<InstructionSet::Avx2>,
+                               PerspectiveAccumulator<T, AccumulatorSize>& accumulator) const
+            {
                 // Define the register:
                 Vec256I ymm0;
 
@@ -110,10 +137,49 @@ namespace MantaRay
                     Avx<T>::Store(ymm0, accumulator.Black, i);
                 }
                 //endregion
-#else
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            /// \brief The SSE4.1 implementation of CopyTo().
+            MANTARAY_TARGET_SSE
+            inline void CopyTo(Target<InstructionSet::Sse>,
+                               PerspectiveAccumulator<T, AccumulatorSize>& accumulator) const
+            {
+                // Define the register:
+                Vec128I xmm0;
+
+                // Define the step size for the loops:
+                constexpr size_t Step = sizeof(Vec128I) / sizeof(T);
+
+                //region White
+                for (size_t i = 0; i < AccumulatorSize; i += Step) {
+                    // Load the accumulator values into the register:
+                    xmm0 = Sse<T>::From(White, i);
+
+                    // Store the register values into the target accumulator:
+                    Sse<T>::Store(xmm0, accumulator.White, i);
+                }
+                //endregion
+
+                //region Black
+                for (size_t i = 0; i < AccumulatorSize; i += Step) {
+                    // Load the accumulator values into the register:
+                    xmm0 = Sse<T>::From(Black, i);
+
+                    // Store the register values into the target accumulator:
+                    Sse<T>::Store(xmm0, accumulator.Black, i);
+                }
+                //endregion
+            }
+#endif
+
+            /// \brief The scalar implementation of CopyTo().
+            inline void CopyTo(Target<InstructionSet::Scalar>,
+                               PerspectiveAccumulator<T, AccumulatorSize>& accumulator) const
+            {
                 std::copy(std::begin(White), std::end(White), std::begin(accumulator.White));
                 std::copy(std::begin(Black), std::end(Black), std::begin(accumulator.Black));
-#endif
             }
 
             /// \brief Loads the bias into the accumulator.
@@ -121,7 +187,7 @@ namespace MantaRay
             /// \details This method is used to load the bias into the accumulator. This is once at the start to
             ///          properly initialize the accumulator, and prevents having to load the bias every time the
             ///          accumulator is updated or inferred from.
-            inline void LoadBias(std::array<T, AccumulatorSize>& bias)
+            inline void LoadBias(const std::array<T, AccumulatorSize>& bias)
             {
                 std::copy(std::begin(bias), std::end(bias), std::begin(White));
                 std::copy(std::begin(bias), std::end(bias), std::begin(Black));
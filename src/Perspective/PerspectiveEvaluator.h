@@ -0,0 +1,263 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_PERSPECTIVEEVALUATOR_H
+#define MANTARAY_PERSPECTIVEEVALUATOR_H
+
+#include <array>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+#include <span>
+#include <bit>
+
+#include "PerspectiveAccumulator.h"
+#include "PerspectiveWeights.h"
+#include "PerspectiveFeatureTransformer.h"
+#include "../SIMD.h"
+#include "../BoardPosition.h"
+#include "../FeatureSet/Chess768.h"
+
+namespace MantaRay
+{
+
+    /// \brief The per-thread state of a Perspective-accounting Neural Network.
+    /// \tparam T The internal input layer type of the network. Currently only int16_t is supported.
+    /// \tparam OT The internal output layer type of the network. Currently only int32_t is supported.
+    /// \tparam Activation The activation function to use.
+    /// \tparam InputSize The size of the input layer.
+    /// \tparam HiddenSize The size of the hidden layer.
+    /// \tparam OutputSize The size of the output layer.
+    /// \tparam AccumulatorStackSize The size of the accumulator stack.
+    /// \tparam Scale The scale factor of the network.
+    /// \tparam QuantizationFeature The quantization factor of the input layer.
+    /// \tparam QuantizationOutput The quantization factor of the output layer.
+    /// \tparam FeatureSet The input feature set, which maps pieces on squares to input layer indices.
+    /// \details This class owns the accumulator stack (through its feature transformer) and the output buffer of a
+    ///          perspective-accounting neural network, and references (but never modifies) a shared set of weights.
+    ///          Many evaluators can therefore be created over the same weights, one for every thread that needs to
+    ///          evaluate positions.
+    /// \see MantaRay::PerspectiveWeights for the shared weights.
+    /// \see MantaRay::PerspectiveNetwork for a network that owns both its weights and its evaluation state.
+    template<typename T, typename OT, typename Activation,
+            uint16_t InputSize, uint16_t HiddenSize, uint16_t OutputSize,
+            uint16_t AccumulatorStackSize, T Scale, T QuantizationFeature, T QuantizationOutput,
+            typename FeatureSet = Chess768>
+    class PerspectiveEvaluator : public PerspectiveFeatureTransformer<T, InputSize, HiddenSize, AccumulatorStackSize,
+                                                                      FeatureSet>
+    {
+
+        // The scale should make sense. Change this later if requested.
+        static_assert(Scale > 0, "This scale constant doesn't seem right.");
+
+        public:
+            using Weights = PerspectiveWeights<T, OT, InputSize, HiddenSize, OutputSize,
+                    QuantizationFeature, QuantizationOutput, FeatureSet>;
+
+            using Transformer = PerspectiveFeatureTransformer<T, InputSize, HiddenSize, AccumulatorStackSize,
+                    FeatureSet>;
+
+        private:
+            const Weights& Parameters;
+
+#ifdef MANTARAY_AVX512
+            alignas(64) std::array<OT, OutputSize> Output;
+#elifdef MANTARAY_AVX2
+            alignas(32) std::array<OT, OutputSize> Output;
+#elifdef MANTARAY_SSE
+            alignas(16) std::array<OT, OutputSize> Output;
+#else
+            std::array<OT, OutputSize> Output;
+#endif
+
+        public:
+            /// \brief The number of positions EvaluateBatch() propagates through the output layer together.
+            constexpr static size_t BatchBlockSize = 16;
+
+            /// \brief The number of positions EvaluateBatch() orders by output bucket at once.
+            constexpr static size_t BatchWindowSize = BatchBlockSize * 16;
+
+            /// \brief Constructs a new PerspectiveEvaluator.
+            /// \tparam W The type of the weights, which may be any type deriving from the weights (such as a
+            ///           PerspectiveNetwork).
+            /// \param weights The weights to evaluate with.
+            /// \details This constructor initializes the accumulator stack. The weights are referenced, not copied,
+            ///          and must outlive the evaluator. Passing a network creates a fresh evaluator over the network's
+            ///          weights, rather than a copy of the network's own evaluation state.
+            template<typename W> requires std::is_base_of_v<Weights, W>
+            __attribute__((unused)) explicit PerspectiveEvaluator(const W& weights) :
+            Transformer(weights.FeatureWeight, weights.FeatureBias), Parameters(weights) {}
+
+            /// \brief Constructs a new PerspectiveEvaluator.
+            /// \param weights The weights to evaluate with.
+            /// \param other The evaluator to copy the evaluation state from.
+            /// \details This constructor copies the accumulator stack of another evaluator, but references the given
+            ///          weights instead of the other evaluator's weights.
+            __attribute__((unused)) PerspectiveEvaluator(const Weights& weights, const PerspectiveEvaluator& other) :
+            Transformer(weights.FeatureWeight, weights.FeatureBias, other), Parameters(weights), Output(other.Output) {}
+
+            PerspectiveEvaluator(const PerspectiveEvaluator&) = default;
+
+            /// \brief Copies the evaluation state of another evaluator.
+            /// \param other The evaluator to copy the evaluation state from.
+            /// \return This evaluator.
+            /// \details The accumulator stack is copied, while this evaluator keeps referencing its own weights.
+            PerspectiveEvaluator& operator=(const PerspectiveEvaluator& other)
+            {
+                Transformer::operator=(other);
+
+                Output = other.Output;
+                return *this;
+            }
+
+            /// \brief Calculates the output bucket of a position from its piece count.
+            /// \param pieceCount The number of pieces on the board (including the kings).
+            /// \return The output bucket, spreading the piece counts from 2 to 32 evenly over the output buckets.
+            __attribute__((unused)) static inline uint8_t OutputBucket(const uint8_t pieceCount)
+            {
+                constexpr uint8_t Divisor = (32 + OutputSize - 1) / OutputSize;
+
+                assert(pieceCount >= 2);
+
+                return std::min<uint8_t>((pieceCount - 2) / Divisor, OutputSize - 1);
+            }
+
+            /// \brief Evaluates the network with respect to the current accumulator.
+            /// \param colorToMove The color to move.
+            /// \return The evaluation of the network with respect to the current accumulator.
+            /// \details This function evaluates the network with respect to the current accumulator, using the first
+            ///          output bucket. The accumulator is assumed to be up to date with the current position, or to
+            ///          have lazily recorded changes that bring it up to date. The evaluation is returned as the output
+            ///          type of the network.
+            __attribute__((unused)) inline OT Evaluate(const uint8_t colorToMove)
+            {
+                return Evaluate(colorToMove, 0);
+            }
+
+            /// \brief Evaluates the network with respect to the current accumulator and an output bucket.
+            /// \param colorToMove The color to move.
+            /// \param bucket The output bucket to evaluate with (see OutputBucket()).
+            /// \return The evaluation of the network with respect to the current accumulator.
+            /// \details Only the selected output is computed, so a network with multiple output buckets evaluates as
+            ///          fast as a network with a single output.
+            __attribute__((unused)) inline OT Evaluate(const uint8_t colorToMove, const uint8_t bucket)
+            {
+                assert(bucket < OutputSize);
+
+                // Fetch the current accumulator, applying any lazily recorded changes:
+                const PerspectiveAccumulator<T, HiddenSize>& accumulator = this->ComputedAccumulator();
+
+                // Activate, flatten, and forward-propagate the accumulator with the bucket's weights:
+                if (colorToMove == 0) Output[bucket] = SIMD::ActivateFlattenAndForwardRow<Activation, T, OT>(
+                        accumulator.White,
+                        accumulator.Black,
+                        Parameters.OutputWeight,
+                        Parameters.OutputBias,
+                        bucket);
+                else                  Output[bucket] = SIMD::ActivateFlattenAndForwardRow<Activation, T, OT>(
+                        accumulator.Black,
+                        accumulator.White,
+                        Parameters.OutputWeight,
+                        Parameters.OutputBias,
+                        bucket);
+
+                // Scale the output with respect to the quantization and return it:
+                return Output[bucket] * Scale / (QuantizationFeature * QuantizationOutput);
+            }
+
+            /// \brief Evaluates a batch of positions from scratch.
+            /// \param positions The positions to evaluate.
+            /// \param output The evaluation of every position, in the same order as the positions.
+            /// \details Every position is evaluated independently of the accumulator stack (which is left untouched),
+            ///          with the output bucket of its piece count (see OutputBucket()). The evaluations are the same as
+            ///          refreshing the accumulator, accumulating every piece and calling Evaluate() for every position:
+            ///
+            ///          The positions are taken BatchWindowSize at a time, ordered by output bucket within the window,
+            ///          and processed in blocks of up to BatchBlockSize positions sharing a bucket. The accumulators of
+            ///          a block are built in a single pass each (the bias and every piece are summed up in registers
+            ///          and written once), and the block is then propagated through the output layer like a matrix
+            ///          multiplication, loading every weight once for a whole group of positions (see
+            ///          SIMD::ActivateFlattenAndForwardBatch()). Ordering a window rather than the whole batch keeps
+            ///          the positions and outputs of a window in cache, and needs no allocation.
+            __attribute__((unused)) void EvaluateBatch(const std::span<const BoardPosition> positions,
+                                                       const std::span<OT> output) const
+            {
+                assert(output.size() >= positions.size());
+
+                // Define the accumulators of a block, from the perspective of the color to move and of the other
+                // color (positions missing from a partial block are propagated with stale accumulators, and their
+                // outputs discarded):
+#ifdef MANTARAY_AVX512
+                alignas(64) std::array<std::array<T, HiddenSize>, BatchBlockSize> us   {};
+                alignas(64) std::array<std::array<T, HiddenSize>, BatchBlockSize> them {};
+#elifdef MANTARAY_AVX2
+                alignas(32) std::array<std::array<T, HiddenSize>, BatchBlockSize> us   {};
+                alignas(32) std::array<std::array<T, HiddenSize>, BatchBlockSize> them {};
+#elifdef MANTARAY_SSE
+                alignas(16) std::array<std::array<T, HiddenSize>, BatchBlockSize> us   {};
+                alignas(16) std::array<std::array<T, HiddenSize>, BatchBlockSize> them {};
+#else
+                std::array<std::array<T, HiddenSize>, BatchBlockSize> us   {};
+                std::array<std::array<T, HiddenSize>, BatchBlockSize> them {};
+#endif
+
+                std::array<OT, BatchBlockSize> block;
+
+                for (size_t w = 0; w < positions.size(); w += BatchWindowSize) {
+                    const size_t size = std::min(BatchWindowSize, positions.size() - w);
+
+                    // Calculate the output bucket of every position of the window, and order the window by bucket
+                    // (a counting sort, which keeps the positions of a bucket in their original order):
+                    std::array<uint8_t , BatchWindowSize> buckets;
+                    std::array<uint16_t, BatchWindowSize> order  ;
+                    std::array<uint16_t, OutputSize + 1 > starts {};
+
+                    for (size_t i = 0; i < size; i++) {
+                        uint8_t pieceCount = 0;
+                        for (const uint64_t (&pieces)[6] : positions[w + i].Bitboards)
+                            for (const uint64_t bitboard : pieces) pieceCount += std::popcount(bitboard);
+
+                        buckets[i] = OutputSize > 1 ? OutputBucket(pieceCount) : 0;
+                        starts[buckets[i] + 1]++;
+                    }
+
+                    for (size_t b = 0; b < OutputSize; b++) starts[b + 1] += starts[b];
+                    for (size_t i = 0; i < size; i++) order[starts[buckets[i]]++] = static_cast<uint16_t>(i);
+
+                    for (size_t i = 0; i < size;) {
+                        const uint8_t bucket = buckets[order[i]];
+
+                        // Build the accumulators of the positions of the block:
+                        size_t count = 0;
+                        while (count < BatchBlockSize && i + count < size && buckets[order[i + count]] == bucket) {
+                            const BoardPosition& position = positions[w + order[i + count]];
+
+                            if (position.ColorToMove == 0)
+                                this->TransformPosition(position.Bitboards, us  [count], them[count]);
+                            else
+                                this->TransformPosition(position.Bitboards, them[count], us  [count]);
+
+                            count++;
+                        }
+
+                        // Activate, flatten, and forward-propagate the accumulators with the bucket's weights:
+                        SIMD::ActivateFlattenAndForwardBatch<Activation, T, OT, HiddenSize, OutputSize, BatchBlockSize>(
+                                us, them, Parameters.OutputWeight, Parameters.OutputBias, bucket, block);
+
+                        // Scale the outputs with respect to the quantization:
+                        for (size_t b = 0; b < count; b++)
+                            output[w + order[i + b]] = block[b] * Scale / (QuantizationFeature * QuantizationOutput);
+
+                        i += count;
+                    }
+                }
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_PERSPECTIVEEVALUATOR_H
@@ -0,0 +1,783 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_PERSPECTIVEFEATURETRANSFORMER_H
+#define MANTARAY_PERSPECTIVEFEATURETRANSFORMER_H
+
+#include <array>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+#include <bit>
+
+#include "PerspectiveAccumulator.h"
+#include "PerspectiveRefreshCache.h"
+#include "../SIMD.h"
+#include "../AccumulatorOperation.h"
+#include "../AccumulatorDelta.h"
+
+namespace MantaRay
+{
+
+    /// \brief The per-thread feature transformer state of a Perspective-accounting Neural Network.
+    /// \tparam T The internal type of the accumulator. Currently only int16_t is supported.
+    /// \tparam InputSize The size of the input layer.
+    /// \tparam HiddenSize The size of the hidden layer (the size of a single perspective's accumulator).
+    /// \tparam AccumulatorStackSize The size of the accumulator stack.
+    /// \tparam FeatureSet The input feature set, which maps pieces on squares to input layer indices.
+    /// \details This class owns the accumulator stack of a perspective-accounting neural network, and implements
+    ///          every way of keeping it up to date with the position (refreshes, eager and lazy updates, and the
+    ///          refresh cache). It references (but never modifies) the feature weights and biases, and leaves the
+    ///          layers that follow the accumulator to the evaluators deriving from it.
+    /// \see MantaRay::PerspectiveEvaluator for an evaluator with a single output layer.
+    /// \see MantaRay::LayeredEvaluator for an evaluator with multiple affine layers.
+    template<typename T, uint16_t InputSize, uint16_t HiddenSize, uint16_t AccumulatorStackSize, typename FeatureSet>
+    class PerspectiveFeatureTransformer
+    {
+
+        // The accumulator stack size should not be 0 or less.
+        static_assert(AccumulatorStackSize > 0, "The accumulator stack size must at least be greater than zero.");
+
+        private:
+            constexpr static uint8_t Pawn = 0;
+            constexpr static uint8_t Rook = 3;
+            constexpr static uint8_t King = 5;
+
+            const std::array<T, InputSize * HiddenSize>& TransformerWeight;
+            const std::array<T, HiddenSize            >& TransformerBias  ;
+
+            std::array<PerspectiveAccumulator<T, HiddenSize>, AccumulatorStackSize> Accumulators;
+            std::array<AccumulatorDelta                     , AccumulatorStackSize> Deltas      ;
+            std::array<bool                                 , AccumulatorStackSize> Computed    ;
+            std::array<std::array<uint8_t, 2>               , AccumulatorStackSize> KingSquares ;
+            uint16_t CurrentAccumulator = 0;
+
+            PerspectiveRefreshCache<T, HiddenSize, FeatureSet> RefreshCache;
+
+            /// \brief Initializes the accumulator stack.
+            /// \details This function initializes the accumulator stack with empty (and thus computed) accumulators.
+            void InitializeAccumulatorStack()
+            {
+                PerspectiveAccumulator<T, HiddenSize> accumulator;
+                std::fill(std::begin(Accumulators), std::end(Accumulators), accumulator);
+                std::fill(std::begin(Computed    ), std::end(Computed    ), true       );
+
+                std::array<uint8_t, 2> kings = { 0, 0 };
+                std::fill(std::begin(KingSquares), std::end(KingSquares), kings);
+
+                RefreshCache.Clear();
+            }
+
+            /// \brief Resets the current accumulator to the bias.
+            inline void LoadBias()
+            {
+                PerspectiveAccumulator<T, HiddenSize>& accumulator = Accumulators[CurrentAccumulator];
+                accumulator.Zero();
+                accumulator.LoadBias(TransformerBias);
+
+                Computed[CurrentAccumulator] = true;
+            }
+
+            /// \brief Calculates the index of a feature with respect to white's perspective.
+            /// \param piece The piece.
+            /// \param color The color of the piece.
+            /// \param sq The square of the piece.
+            /// \param kings The king squares of the accumulator.
+            /// \return The offset of the feature's weights in the feature weight array.
+            static inline uint32_t WhiteIndex(const uint8_t piece, const uint8_t color, const uint8_t sq,
+                                              const std::array<uint8_t, 2>& kings)
+            {
+                return FeatureSet::Index(0, piece, color, sq, kings[0]) * HiddenSize;
+            }
+
+            /// \brief Calculates the index of a feature with respect to black's perspective.
+            /// \param piece The piece.
+            /// \param color The color of the piece.
+            /// \param sq The square of the piece.
+            /// \param kings The king squares of the accumulator.
+            /// \return The offset of the feature's weights in the feature weight array.
+            static inline uint32_t BlackIndex(const uint8_t piece, const uint8_t color, const uint8_t sq,
+                                              const std::array<uint8_t, 2>& kings)
+            {
+                return FeatureSet::Index(1, piece, color, sq, kings[1]) * HiddenSize;
+            }
+
+            /// \brief Tracks the square of a king in the current accumulator.
+            /// \param color The color of the king.
+            /// \param sq The square of the king.
+            /// \details The king squares are only tracked if the feature set depends on them.
+            inline void PlaceKing(const uint8_t color, const uint8_t sq)
+            {
+                if constexpr (FeatureSet::KingRelative) KingSquares[CurrentAccumulator][color] = sq;
+            }
+
+            /// \brief Tracks a piece move in the current accumulator's king squares.
+            /// \param piece The piece that is moved.
+            /// \param color The color of the piece that is moved.
+            /// \param to The square the piece is moved to.
+            /// \details If the move requires a refresh, the perspective of the moved king is only valid again once it
+            ///          has been refreshed.
+            inline void TrackMove(const uint8_t piece, const uint8_t color, const uint8_t to)
+            {
+                if (piece == King) PlaceKing(color, to);
+            }
+
+            /// \brief Applies a set of feature changes to an accumulator in a single pass.
+            /// \tparam SubtractCount The number of deactivated features.
+            /// \tparam AddCount The number of activated features.
+            /// \param parent The accumulator the changes are applied on top of.
+            /// \param child The accumulator to store the result in (may be the parent accumulator).
+            /// \param kings The king squares of the child accumulator.
+            /// \param deactivated The deactivated features.
+            /// \param activated The activated features.
+            template<size_t SubtractCount, size_t AddCount>
+            inline void UpdateAccumulator(const PerspectiveAccumulator<T, HiddenSize>& parent,
+                                          PerspectiveAccumulator<T, HiddenSize>& child,
+                                          const std::array<uint8_t, 2>& kings,
+                                          const std::array<PieceFeature, SubtractCount>& deactivated,
+                                          const std::array<PieceFeature, AddCount     >& activated)
+            {
+                // Calculate the indices of the changed features with respect to both perspectives:
+                std::array<uint32_t, SubtractCount> whiteSubtract;
+                std::array<uint32_t, SubtractCount> blackSubtract;
+                std::array<uint32_t, AddCount     > whiteAdd     ;
+                std::array<uint32_t, AddCount     > blackAdd     ;
+
+                for (size_t i = 0; i < SubtractCount; i++) {
+                    const PieceFeature& f = deactivated[i];
+
+                    whiteSubtract[i] = WhiteIndex(f.Piece, f.Color, f.Square, kings);
+                    blackSubtract[i] = BlackIndex(f.Piece, f.Color, f.Square, kings);
+                }
+
+                for (size_t i = 0; i < AddCount; i++) {
+                    const PieceFeature& f = activated[i];
+
+                    whiteAdd[i] = WhiteIndex(f.Piece, f.Color, f.Square, kings);
+                    blackAdd[i] = BlackIndex(f.Piece, f.Color, f.Square, kings);
+                }
+
+                // Apply all changes in a single pass over the accumulator:
+                SIMD::SubtractAndAddToAll<SubtractCount, AddCount>(parent.White, parent.Black,
+                                                                   child.White, child.Black,
+                                                                   TransformerWeight,
+                                                                   whiteSubtract, whiteAdd,
+                                                                   blackSubtract, blackAdd);
+            }
+
+            /// \brief Applies the recorded changes of a move to the accumulator of the next ply.
+            /// \tparam SubtractCount The number of recorded deactivations.
+            /// \tparam AddCount The number of recorded activations.
+            /// \param parent The accumulator the changes are applied on top of.
+            /// \param child The accumulator to store the result in.
+            /// \param kings The king squares of the child accumulator.
+            /// \param delta The recorded changes.
+            template<size_t SubtractCount, size_t AddCount>
+            inline void ApplyDelta(const PerspectiveAccumulator<T, HiddenSize>& parent,
+                                   PerspectiveAccumulator<T, HiddenSize>& child,
+                                   const std::array<uint8_t, 2>& kings, const AccumulatorDelta& delta)
+            {
+                std::array<PieceFeature, SubtractCount> deactivated;
+                std::array<PieceFeature, AddCount     > activated  ;
+
+                std::copy_n(std::begin(delta.Deactivated), SubtractCount, std::begin(deactivated));
+                std::copy_n(std::begin(delta.Activated  ), AddCount     , std::begin(activated  ));
+
+                UpdateAccumulator<SubtractCount, AddCount>(parent, child, kings, deactivated, activated);
+            }
+
+            /// \brief Applies the recorded changes of a move to the accumulator of the next ply.
+            /// \param parent The accumulator the changes are applied on top of.
+            /// \param child The accumulator to store the result in.
+            /// \param kings The king squares of the child accumulator.
+            /// \param delta The recorded changes.
+            /// \details The copy from the parent accumulator and all recorded changes are applied in a single pass,
+            ///          using the kernel sized for the recorded number of changes.
+            inline void ApplyDelta(const PerspectiveAccumulator<T, HiddenSize>& parent,
+                                   PerspectiveAccumulator<T, HiddenSize>& child,
+                                   const std::array<uint8_t, 2>& kings, const AccumulatorDelta& delta)
+            {
+                const uint8_t d = delta.DeactivatedCount;
+                const uint8_t a = delta.ActivatedCount  ;
+
+                // Ordered by how common the corresponding moves are (quiet move, capture, castling, ...):
+                if      (d == 1 && a == 1) ApplyDelta<1, 1>(parent, child, kings, delta);
+                else if (d == 2 && a == 1) ApplyDelta<2, 1>(parent, child, kings, delta);
+                else if (d == 2 && a == 2) ApplyDelta<2, 2>(parent, child, kings, delta);
+                else if (d == 1 && a == 0) ApplyDelta<1, 0>(parent, child, kings, delta);
+                else if (d == 0 && a == 1) ApplyDelta<0, 1>(parent, child, kings, delta);
+                else if (d == 1 && a == 2) ApplyDelta<1, 2>(parent, child, kings, delta);
+                else if (d == 2 && a == 0) ApplyDelta<2, 0>(parent, child, kings, delta);
+                else if (d == 0 && a == 2) ApplyDelta<0, 2>(parent, child, kings, delta);
+                else {
+                    // The record is bounded by MaxChanges, so the only case left is a push without any changes:
+                    static_assert(AccumulatorDelta::MaxChanges == 2, "Every recordable delta must be dispatched.");
+                    assert(d == 0 && a == 0);
+
+                    parent.CopyTo(child);
+                }
+            }
+
+            /// \brief Brings the current accumulator up to date.
+            /// \details This function walks back the accumulator stack to the closest accumulator that has been
+            ///          computed, and then replays the recorded changes of every ply from there up to the current
+            ///          accumulator.
+            void MaterializeAccumulator()
+            {
+                // Find the closest computed ancestor:
+                uint16_t computed = CurrentAccumulator;
+                while (!Computed[computed]) {
+                    assert(computed > 0);
+
+                    computed--;
+                }
+
+                // Replay the changes of every ply after it:
+                for (uint16_t i = computed + 1; i <= CurrentAccumulator; i++) {
+                    ApplyDelta(Accumulators[i - 1], Accumulators[i], KingSquares[i], Deltas[i]);
+
+                    Computed[i] = true;
+                }
+            }
+
+            /// \brief Records a feature change in the current accumulator, applying it directly if it can't be recorded.
+            /// \tparam Operation The operation to perform on the accumulator.
+            /// \param piece The piece that is inserted or removed.
+            /// \param color The color of the piece that is inserted or removed.
+            /// \param sq The square the piece is inserted or removed from.
+            /// \details Once the record of a ply is full, the ply is materialized, and the changes that follow are
+            ///          applied to the (now computed) accumulator directly.
+            template<AccumulatorOperation Operation>
+            inline void RecordLazily(const uint8_t piece, const uint8_t color, const uint8_t sq)
+            {
+                if (!Computed[CurrentAccumulator]) {
+                    if (Deltas[CurrentAccumulator].template Record<Operation>(piece, color, sq)) {
+                        if (Operation == AccumulatorOperation::Activate && piece == King) PlaceKing(color, sq);
+
+                        return;
+                    }
+
+                    MaterializeAccumulator();
+                }
+
+                EfficientlyUpdateAccumulator<Operation>(piece, color, sq);
+            }
+
+            /// \brief Advances the accumulator stack by one ply, carrying over the king squares.
+            /// \return The new current accumulator, which the caller must fully compute.
+            inline PerspectiveAccumulator<T, HiddenSize>& ChildAccumulator()
+            {
+                ++CurrentAccumulator;
+
+                assert(CurrentAccumulator < AccumulatorStackSize);
+
+                if constexpr (FeatureSet::KingRelative)
+                    KingSquares[CurrentAccumulator] = KingSquares[CurrentAccumulator - 1];
+
+                Computed[CurrentAccumulator] = true;
+                return Accumulators[CurrentAccumulator];
+            }
+
+        protected:
+            /// \brief Constructs a new PerspectiveFeatureTransformer.
+            /// \param weight The feature weights to transform with.
+            /// \param bias The feature biases to transform with.
+            /// \details This constructor initializes the accumulator stack. The weights and biases are referenced, not
+            ///          copied, and must outlive the transformer.
+            PerspectiveFeatureTransformer(const std::array<T, InputSize * HiddenSize>& weight,
+                                          const std::array<T, HiddenSize            >& bias) :
+            TransformerWeight(weight), TransformerBias(bias)
+            {
+                InitializeAccumulatorStack();
+            }
+
+            /// \brief Constructs a new PerspectiveFeatureTransformer.
+            /// \param weight The feature weights to transform with.
+            /// \param bias The feature biases to transform with.
+            /// \param other The transformer to copy the accumulator stack from.
+            /// \details This constructor copies the accumulator stack of another transformer, but references the given
+            ///          weights and biases instead of the other transformer's weights and biases.
+            PerspectiveFeatureTransformer(const std::array<T, InputSize * HiddenSize>& weight,
+                                          const std::array<T, HiddenSize            >& bias,
+                                          const PerspectiveFeatureTransformer& other) :
+            TransformerWeight(weight), TransformerBias(bias), Accumulators(other.Accumulators), Deltas(other.Deltas),
+            Computed(other.Computed), KingSquares(other.KingSquares), CurrentAccumulator(other.CurrentAccumulator),
+            RefreshCache(other.RefreshCache) {}
+
+            PerspectiveFeatureTransformer(const PerspectiveFeatureTransformer&) = default;
+
+            /// \brief Copies the accumulator stack of another transformer.
+            /// \param other The transformer to copy the accumulator stack from.
+            /// \return This transformer.
+            /// \details The accumulator stack is copied, while this transformer keeps referencing its own weights and
+            ///          biases.
+            PerspectiveFeatureTransformer& operator=(const PerspectiveFeatureTransformer& other)
+            {
+                Accumulators       = other.Accumulators      ;
+                Deltas             = other.Deltas            ;
+                Computed           = other.Computed          ;
+                KingSquares        = other.KingSquares       ;
+                CurrentAccumulator = other.CurrentAccumulator;
+                RefreshCache       = other.RefreshCache      ;
+                return *this;
+            }
+
+            /// \brief Builds the accumulators of both perspectives of a position from scratch.
+            /// \param bitboards The piece bitboards of the position, indexed by color and then piece.
+            /// \param white The accumulator of white's perspective to build.
+            /// \param black The accumulator of black's perspective to build.
+            /// \details The features of both perspectives are gathered in a single pass over the bitboards, and the
+            ///          bias and the weights of every feature are then summed up in a single pass over each
+            ///          accumulator, which is written exactly once. This doesn't touch the accumulator stack.
+            inline void TransformPosition(const uint64_t (&bitboards)[2][6], std::array<T, HiddenSize>& white,
+                                          std::array<T, HiddenSize>& black) const
+            {
+                constexpr std::array<uint32_t, 0> none {};
+
+                // A board has 64 squares, so no more than 64 features can be active at once:
+                std::array<uint32_t, 64> whiteFeatures;
+                std::array<uint32_t, 64> blackFeatures;
+                size_t count = 0;
+
+                const auto whiteKing = static_cast<uint8_t>(std::countr_zero(bitboards[0][King]));
+                const auto blackKing = static_cast<uint8_t>(std::countr_zero(bitboards[1][King]));
+
+                for (uint8_t color = 0; color < 2; color++)
+                    for (uint8_t piece = 0; piece < 6; piece++)
+                        for (uint64_t pieces = bitboards[color][piece]; pieces; pieces &= pieces - 1) {
+                            const auto sq = static_cast<uint8_t>(std::countr_zero(pieces));
+
+                            whiteFeatures[count] = FeatureSet::Index(0, piece, color, sq, whiteKing) * HiddenSize;
+                            blackFeatures[count] = FeatureSet::Index(1, piece, color, sq, blackKing) * HiddenSize;
+                            count++;
+                        }
+
+                SIMD::SubtractAndAddToAll(TransformerBias, white, TransformerWeight, none, 0, whiteFeatures, count);
+                SIMD::SubtractAndAddToAll(TransformerBias, black, TransformerWeight, none, 0, blackFeatures, count);
+            }
+
+            /// \brief Fetches the current accumulator, bringing it up to date first.
+            /// \return The current accumulator, with any lazily recorded changes applied.
+            inline const PerspectiveAccumulator<T, HiddenSize>& ComputedAccumulator()
+            {
+                if (!Computed[CurrentAccumulator]) MaterializeAccumulator();
+
+                return Accumulators[CurrentAccumulator];
+            }
+
+        public:
+            /// \brief Reset the accumulator stack counter.
+            /// \details This function resets the accumulator stack counter to zero.
+            __attribute__((unused)) inline void ResetAccumulator()
+            {
+                CurrentAccumulator = 0;
+            }
+
+            /// \brief Pushes the current accumulator to the stack.
+            /// \details This function pushes the current accumulator to the stack. This is useful when you want to
+            ///          efficiently update the accumulator with a new piece move, but you want to keep the current
+            ///          accumulator for later use (such as undoing).
+            __attribute__((unused)) inline void PushAccumulator()
+            {
+                const PerspectiveAccumulator<T, HiddenSize>& parent = ComputedAccumulator();
+                parent.CopyTo(ChildAccumulator());
+            }
+
+            /// \brief Pushes the current accumulator to the stack and applies a quiet move to it.
+            /// \param piece The piece that is moved.
+            /// \param color The color of the piece that is moved.
+            /// \param from The square the piece is moved from.
+            /// \param to The square the piece is moved to.
+            /// \details This function is equivalent to PushAccumulator() followed by EfficientlyUpdateAccumulator(),
+            ///          but reads the parent accumulator and writes the child accumulator only once.
+            __attribute__((unused)) inline void PushAccumulatorWithMove(const uint8_t piece, const uint8_t color,
+                                                                        const uint8_t from, const uint8_t to)
+            {
+                const PerspectiveAccumulator<T, HiddenSize>& parent = ComputedAccumulator();
+                PerspectiveAccumulator<T, HiddenSize>& child = ChildAccumulator();
+
+                TrackMove(piece, color, to);
+
+                UpdateAccumulator<1, 1>(parent, child, KingSquares[CurrentAccumulator],
+                                        {{ { piece, color, from } }},
+                                        {{ { piece, color,   to } }});
+            }
+
+            /// \brief Pushes the current accumulator to the stack and applies a capture to it.
+            /// \param piece The piece that is moved.
+            /// \param color The color of the piece that is moved.
+            /// \param from The square the piece is moved from.
+            /// \param to The square the piece is moved to.
+            /// \param captured The piece that is captured.
+            /// \param capturedSq The square of the captured piece (differs from the target square for en passant).
+            /// \details The captured piece is of the opposite color. The capture is applied in a single pass fused
+            ///          with the copy from the parent accumulator.
+            __attribute__((unused)) inline void PushAccumulatorWithCapture(const uint8_t piece, const uint8_t color,
+                                                                           const uint8_t from, const uint8_t to,
+                                                                           const uint8_t captured,
+                                                                           const uint8_t capturedSq)
+            {
+                const PerspectiveAccumulator<T, HiddenSize>& parent = ComputedAccumulator();
+                PerspectiveAccumulator<T, HiddenSize>& child = ChildAccumulator();
+
+                TrackMove(piece, color, to);
+
+                UpdateAccumulator<2, 1>(parent, child, KingSquares[CurrentAccumulator],
+                                        {{ { piece, color, from }, { captured, uint8_t(color ^ 1), capturedSq } }},
+                                        {{ { piece, color,   to } }});
+            }
+
+            /// \brief Pushes the current accumulator to the stack and applies a castling move to it.
+            /// \param color The color of the side castling.
+            /// \param kingFrom The square the king is moved from.
+            /// \param kingTo The square the king is moved to.
+            /// \param rookFrom The square the rook is moved from.
+            /// \param rookTo The square the rook is moved to.
+            /// \details Both the king and rook move are applied in a single pass fused with the copy from the parent
+            ///          accumulator.
+            __attribute__((unused)) inline void PushAccumulatorWithCastling(const uint8_t color,
+                                                                            const uint8_t kingFrom,
+                                                                            const uint8_t kingTo,
+                                                                            const uint8_t rookFrom,
+                                                                            const uint8_t rookTo)
+            {
+                const PerspectiveAccumulator<T, HiddenSize>& parent = ComputedAccumulator();
+                PerspectiveAccumulator<T, HiddenSize>& child = ChildAccumulator();
+
+                TrackMove(King, color, kingTo);
+
+                UpdateAccumulator<2, 2>(parent, child, KingSquares[CurrentAccumulator],
+                                        {{ { King, color, kingFrom }, { Rook, color, rookFrom } }},
+                                        {{ { King, color, kingTo   }, { Rook, color, rookTo   } }});
+            }
+
+            /// \brief Pushes the current accumulator to the stack and applies a promotion to it.
+            /// \param color The color of the promoting pawn.
+            /// \param from The square the pawn is moved from.
+            /// \param to The square the pawn is promoted on.
+            /// \param promotion The piece the pawn is promoted to.
+            /// \details The promotion is applied in a single pass fused with the copy from the parent accumulator.
+            __attribute__((unused)) inline void PushAccumulatorWithPromotion(const uint8_t color,
+                                                                             const uint8_t from, const uint8_t to,
+                                                                             const uint8_t promotion)
+            {
+                const PerspectiveAccumulator<T, HiddenSize>& parent = ComputedAccumulator();
+                PerspectiveAccumulator<T, HiddenSize>& child = ChildAccumulator();
+
+                UpdateAccumulator<1, 1>(parent, child, KingSquares[CurrentAccumulator],
+                                        {{ { Pawn     , color, from } }},
+                                        {{ { promotion, color,   to } }});
+            }
+
+            /// \brief Pushes the current accumulator to the stack and applies a capturing promotion to it.
+            /// \param color The color of the promoting pawn.
+            /// \param from The square the pawn is moved from.
+            /// \param to The square the pawn is promoted on.
+            /// \param promotion The piece the pawn is promoted to.
+            /// \param captured The piece that is captured on the promotion square.
+            /// \details The promotion and capture are applied in a single pass fused with the copy from the parent
+            ///          accumulator.
+            __attribute__((unused)) inline void PushAccumulatorWithPromotionCapture(const uint8_t color,
+                                                                                    const uint8_t from,
+                                                                                    const uint8_t to,
+                                                                                    const uint8_t promotion,
+                                                                                    const uint8_t captured)
+            {
+                const PerspectiveAccumulator<T, HiddenSize>& parent = ComputedAccumulator();
+                PerspectiveAccumulator<T, HiddenSize>& child = ChildAccumulator();
+
+                UpdateAccumulator<2, 1>(parent, child, KingSquares[CurrentAccumulator],
+                                        {{ { Pawn, color, from }, { captured, uint8_t(color ^ 1), to } }},
+                                        {{ { promotion, color, to } }});
+            }
+
+            /// \brief Lazily pushes the current accumulator to the stack.
+            /// \details This function pushes a new accumulator to the stack without computing it. The changes of
+            ///          the move must then be recorded using LazilyUpdateAccumulator(), and are only applied once the
+            ///          accumulator is needed by Evaluate(). Nodes that are never evaluated thus never pay for the
+            ///          copy and update of the accumulator.
+            __attribute__((unused)) inline void LazilyPushAccumulator()
+            {
+                ++CurrentAccumulator;
+
+                assert(CurrentAccumulator < AccumulatorStackSize);
+
+                if constexpr (FeatureSet::KingRelative)
+                    KingSquares[CurrentAccumulator] = KingSquares[CurrentAccumulator - 1];
+
+                Deltas  [CurrentAccumulator].Clear();
+                Computed[CurrentAccumulator] = false;
+            }
+
+            /// \brief Pulls the current accumulator from the stack.
+            /// \details This function pulls the current accumulator from the stack. This is useful when you want to
+            ///          undo a move and restore the previous accumulator.
+            __attribute__((unused)) inline void PullAccumulator()
+            {
+                assert(CurrentAccumulator > 0);
+
+                CurrentAccumulator--;
+            }
+
+            /// \brief Refreshes the current accumulator.
+            /// \details This function refreshes the current accumulator with the bias, effectively resetting it to
+            ///          the initial state before any pieces were accumulated. It is only available for feature sets
+            ///          that do not depend on the king squares.
+            __attribute__((unused)) inline void RefreshAccumulator()
+            {
+                static_assert(!FeatureSet::KingRelative,
+                        "This feature set depends on the king squares. Use RefreshAccumulator(whiteKing, blackKing).");
+
+                LoadBias();
+            }
+
+            /// \brief Refreshes the current accumulator for the given king squares.
+            /// \param whiteKing The square of the white king.
+            /// \param blackKing The square of the black king.
+            /// \details This function refreshes the current accumulator with the bias, and sets the king squares the
+            ///          pieces accumulated afterwards are indexed against. Feature sets that depend on the king
+            ///          squares must be refreshed using this overload.
+            __attribute__((unused)) inline void RefreshAccumulator(const uint8_t whiteKing, const uint8_t blackKing)
+            {
+                LoadBias();
+
+                PlaceKing(0, whiteKing);
+                PlaceKing(1, blackKing);
+            }
+
+            /// \brief Refreshes a single perspective of the current accumulator using the refresh cache.
+            /// \param perspective The perspective to refresh (0 for white, 1 for black).
+            /// \param bitboards The piece bitboards of the current position, indexed by color and then piece.
+            /// \details The accumulator of the perspective is rebuilt from the cached accumulator of the perspective's
+            ///          king bucket, applying only the pieces that differ from the position cached for that bucket.
+            ///          This is meant to follow a king move for which RequiresRefresh() is true, in which case the
+            ///          perspective of the moved king is refreshed while the other perspective is updated
+            ///          incrementally as usual.
+            __attribute__((unused)) inline void RefreshAccumulator(const uint8_t perspective,
+                                                                   const uint64_t (&bitboards)[2][6])
+            {
+                if (!Computed[CurrentAccumulator]) MaterializeAccumulator();
+
+                const auto king = static_cast<uint8_t>(std::countr_zero(bitboards[perspective][King]));
+                PlaceKing(perspective, king);
+
+                PerspectiveAccumulator<T, HiddenSize>& accumulator = Accumulators[CurrentAccumulator];
+                RefreshCache.Refresh(perspective, king, bitboards, TransformerWeight, TransformerBias,
+                                     perspective == 0 ? accumulator.White : accumulator.Black);
+            }
+
+            /// \brief Checks whether a piece move requires the accumulator to be refreshed.
+            /// \param piece The piece that is moved.
+            /// \param color The color of the piece that is moved.
+            /// \param from The square the piece is moved from.
+            /// \param to The square the piece is moved to.
+            /// \return True if the move cannot be applied incrementally with respect to the feature set.
+            /// \details For feature sets that depend on the king square, a king move that changes the king's bucket
+            ///          changes the index of every feature of that perspective. Such moves are pushed (or applied)
+            ///          like any other move, but must then be followed by RefreshAccumulator(color, bitboards) to
+            ///          refresh the perspective of the moved king.
+            __attribute__((unused)) static inline bool RequiresRefresh(const uint8_t piece, const uint8_t color,
+                                                                       const uint8_t from, const uint8_t to)
+            {
+                return piece == King && FeatureSet::RequiresRefresh(color, from, to);
+            }
+
+            /// \brief Efficiently updates the current accumulator with a new piece move.
+            /// \param piece The piece that is moved.
+            /// \param color The color of the piece that is moved.
+            /// \param from The square the piece is moved from.
+            /// \param to The square the piece is moved to.
+            /// \details This function efficiently updates the current accumulator with a new piece move. This is
+            ///          done by subtracting the piece from the square it is moved from and adding it to the square
+            ///          it is moved to. This is much more efficient than calling RefreshAccumulator() and then
+            ///          accumulating all pieces again.
+            __attribute__((unused)) inline void EfficientlyUpdateAccumulator(const uint8_t piece, const uint8_t color,
+                                                                             const uint8_t from, const uint8_t to)
+            {
+                assert(Computed[CurrentAccumulator]);
+
+                // Track the king square, in case the king is moved:
+                TrackMove(piece, color, to);
+
+                // Fetch the current accumulator:
+                PerspectiveAccumulator<T, HiddenSize>& accumulator = Accumulators[CurrentAccumulator];
+
+                // Efficiently update the accumulator:
+                UpdateAccumulator<1, 1>(accumulator, accumulator, KingSquares[CurrentAccumulator],
+                                        {{ { piece, color, from } }},
+                                        {{ { piece, color,   to } }});
+            }
+
+            /// \brief Efficiently updates the current accumulator with a new piece insertion or removal.
+            /// \tparam Operation The operation to perform on the accumulator.
+            /// \param piece The piece that is inserted or removed.
+            /// \param color The color of the piece that is inserted or removed.
+            /// \param sq The square the piece is inserted or removed from.
+            /// \details This function efficiently updates the current accumulator with a new piece insertion or
+            ///          removal. This is done by adding or subtracting the piece from the square it is inserted
+            ///          or removed from. This is much more efficient than calling the non-templated version of
+            ///          this function.
+            /// \see MantaRay::AccumulatorOperation for the available operations.
+            template<AccumulatorOperation Operation>
+            __attribute__((unused)) inline void EfficientlyUpdateAccumulator(const uint8_t piece, const uint8_t color,
+                                                                             const uint8_t sq)
+            {
+                assert(Computed[CurrentAccumulator]);
+
+                // Track the king square, in case the king is inserted:
+                if (Operation == AccumulatorOperation::Activate && piece == King) PlaceKing(color, sq);
+                const std::array<uint8_t, 2>& kings = KingSquares[CurrentAccumulator];
+
+                // Fetch the current accumulator:
+                PerspectiveAccumulator<T, HiddenSize>& accumulator = Accumulators[CurrentAccumulator];
+
+                // Efficiently update the accumulator:
+                if (Operation == AccumulatorOperation::Activate)
+                    SIMD::AddToAll(accumulator.White,
+                                   accumulator.Black,
+                                   TransformerWeight,
+                                   WhiteIndex(piece, color, sq, kings),
+                                   BlackIndex(piece, color, sq, kings));
+
+                else SIMD::SubtractFromAll(accumulator.White,
+                                           accumulator.Black,
+                                           TransformerWeight,
+                                           WhiteIndex(piece, color, sq, kings),
+                                           BlackIndex(piece, color, sq, kings));
+            }
+
+            /// \brief Efficiently updates the current accumulator with a capture.
+            /// \param piece The piece that is moved.
+            /// \param color The color of the piece that is moved.
+            /// \param from The square the piece is moved from.
+            /// \param to The square the piece is moved to.
+            /// \param captured The piece that is captured.
+            /// \param capturedSq The square of the captured piece (differs from the target square for en passant).
+            /// \details The captured piece is of the opposite color. Both the move and the removal of the captured
+            ///          piece are applied in a single pass over the accumulator.
+            __attribute__((unused)) inline void EfficientlyUpdateAccumulatorWithCapture(const uint8_t piece,
+                                                                                        const uint8_t color,
+                                                                                        const uint8_t from,
+                                                                                        const uint8_t to,
+                                                                                        const uint8_t captured,
+                                                                                        const uint8_t capturedSq)
+            {
+                assert(Computed[CurrentAccumulator]);
+
+                TrackMove(piece, color, to);
+
+                PerspectiveAccumulator<T, HiddenSize>& accumulator = Accumulators[CurrentAccumulator];
+
+                UpdateAccumulator<2, 1>(accumulator, accumulator, KingSquares[CurrentAccumulator],
+                                        {{ { piece, color, from }, { captured, uint8_t(color ^ 1), capturedSq } }},
+                                        {{ { piece, color,   to } }});
+            }
+
+            /// \brief Efficiently updates the current accumulator with a castling move.
+            /// \param color The color of the side castling.
+            /// \param kingFrom The square the king is moved from.
+            /// \param kingTo The square the king is moved to.
+            /// \param rookFrom The square the rook is moved from.
+            /// \param rookTo The square the rook is moved to.
+            /// \details Both the king and rook move are applied in a single pass over the accumulator.
+            __attribute__((unused)) inline void EfficientlyUpdateAccumulatorWithCastling(const uint8_t color,
+                                                                                         const uint8_t kingFrom,
+                                                                                         const uint8_t kingTo,
+                                                                                         const uint8_t rookFrom,
+                                                                                         const uint8_t rookTo)
+            {
+                assert(Computed[CurrentAccumulator]);
+
+                TrackMove(King, color, kingTo);
+
+                PerspectiveAccumulator<T, HiddenSize>& accumulator = Accumulators[CurrentAccumulator];
+
+                UpdateAccumulator<2, 2>(accumulator, accumulator, KingSquares[CurrentAccumulator],
+                                        {{ { King, color, kingFrom }, { Rook, color, rookFrom } }},
+                                        {{ { King, color, kingTo   }, { Rook, color, rookTo   } }});
+            }
+
+            /// \brief Efficiently updates the current accumulator with a promotion.
+            /// \param color The color of the promoting pawn.
+            /// \param from The square the pawn is moved from.
+            /// \param to The square the pawn is promoted on.
+            /// \param promotion The piece the pawn is promoted to.
+            /// \details The removal of the pawn and the insertion of the promoted piece are applied in a single pass
+            ///          over the accumulator.
+            __attribute__((unused)) inline void EfficientlyUpdateAccumulatorWithPromotion(const uint8_t color,
+                                                                                          const uint8_t from,
+                                                                                          const uint8_t to,
+                                                                                          const uint8_t promotion)
+            {
+                assert(Computed[CurrentAccumulator]);
+
+                PerspectiveAccumulator<T, HiddenSize>& accumulator = Accumulators[CurrentAccumulator];
+
+                UpdateAccumulator<1, 1>(accumulator, accumulator, KingSquares[CurrentAccumulator],
+                                        {{ { Pawn     , color, from } }},
+                                        {{ { promotion, color,   to } }});
+            }
+
+            /// \brief Efficiently updates the current accumulator with a capturing promotion.
+            /// \param color The color of the promoting pawn.
+            /// \param from The square the pawn is moved from.
+            /// \param to The square the pawn is promoted on.
+            /// \param promotion The piece the pawn is promoted to.
+            /// \param captured The piece that is captured on the promotion square.
+            /// \details The removal of the pawn and the captured piece and the insertion of the promoted piece are
+            ///          applied in a single pass over the accumulator.
+            __attribute__((unused)) inline void EfficientlyUpdateAccumulatorWithPromotionCapture(
+                    const uint8_t color, const uint8_t from, const uint8_t to,
+                    const uint8_t promotion, const uint8_t captured)
+            {
+                assert(Computed[CurrentAccumulator]);
+
+                PerspectiveAccumulator<T, HiddenSize>& accumulator = Accumulators[CurrentAccumulator];
+
+                UpdateAccumulator<2, 1>(accumulator, accumulator, KingSquares[CurrentAccumulator],
+                                        {{ { Pawn, color, from }, { captured, uint8_t(color ^ 1), to } }},
+                                        {{ { promotion, color, to } }});
+            }
+
+            /// \brief Lazily records a new piece move in the current accumulator.
+            /// \param piece The piece that is moved.
+            /// \param color The color of the piece that is moved.
+            /// \param from The square the piece is moved from.
+            /// \param to The square the piece is moved to.
+            /// \details This function records the piece move without updating the accumulator. It must only be used
+            ///          after LazilyPushAccumulator(), and the move is applied when the accumulator is next evaluated.
+            ///          If the record of the ply is full, the accumulator is brought up to date and the move is
+            ///          applied directly instead.
+            __attribute__((unused)) inline void LazilyUpdateAccumulator(const uint8_t piece, const uint8_t color,
+                                                                        const uint8_t from, const uint8_t to)
+            {
+                TrackMove(piece, color, to);
+
+                RecordLazily<AccumulatorOperation::Deactivate>(piece, color, from);
+                RecordLazily<AccumulatorOperation::Activate  >(piece, color,   to);
+            }
+
+            /// \brief Lazily records a new piece insertion or removal in the current accumulator.
+            /// \tparam Operation The operation to perform on the accumulator.
+            /// \param piece The piece that is inserted or removed.
+            /// \param color The color of the piece that is inserted or removed.
+            /// \param sq The square the piece is inserted or removed from.
+            /// \details This function records the piece insertion or removal without updating the accumulator. It
+            ///          must only be used after LazilyPushAccumulator(), and the change is applied when the
+            ///          accumulator is next evaluated. If the record of the ply is full, the accumulator is brought up
+            ///          to date and the change is applied directly instead.
+            /// \see MantaRay::AccumulatorOperation for the available operations.
+            template<AccumulatorOperation Operation>
+            __attribute__((unused)) inline void LazilyUpdateAccumulator(const uint8_t piece, const uint8_t color,
+                                                                        const uint8_t sq)
+            {
+                RecordLazily<Operation>(piece, color, sq);
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_PERSPECTIVEFEATURETRANSFORMER_H
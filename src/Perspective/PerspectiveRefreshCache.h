@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_PERSPECTIVEREFRESHCACHE_H
+#define MANTARAY_PERSPECTIVEREFRESHCACHE_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <algorithm>
+
+#include "../SIMD.h"
+
+namespace MantaRay
+{
+
+    /// \brief The refresh cache (also known as a "Finny table") of a Perspective-accounting Neural Network.
+    /// \tparam T The internal type of the accumulator.
+    /// \tparam AccumulatorSize The size of the accumulator.
+    /// \tparam FeatureSet The input feature set of the network.
+    /// \details For every perspective and every feature mapping (king bucket) of that perspective, the cache stores
+    ///          the accumulator of the last position refreshed in that bucket, along with the piece bitboards of that
+    ///          position. Refreshing a perspective then only applies the difference between the cached position and
+    ///          the new position, which is usually a handful of pieces instead of every piece on the board.
+    ///
+    ///          Entries are loaded with the bias the first time they are used, so the cache must be cleared if the
+    ///          weights it is used with change.
+    template<typename T, size_t AccumulatorSize, typename FeatureSet>
+    class PerspectiveRefreshCache
+    {
+
+        private:
+            constexpr static uint8_t ColorCount = 2;
+            constexpr static uint8_t PieceCount = 6;
+
+            // A board has 64 squares, so no more than 64 features can be added or removed at once.
+            constexpr static uint8_t MaxChanges = 64;
+
+            struct Entry
+            {
+
+#ifdef MANTARAY_AVX512
+                alignas(64) std::array<T, AccumulatorSize> Accumulator;
+#elifdef MANTARAY_AVX2
+                alignas(32) std::array<T, AccumulatorSize> Accumulator;
+#elifdef MANTARAY_SSE
+                alignas(16) std::array<T, AccumulatorSize> Accumulator;
+#else
+                std::array<T, AccumulatorSize> Accumulator;
+#endif
+
+                std::array<std::array<uint64_t, PieceCount>, ColorCount> Bitboards;
+                bool Loaded = false;
+
+            };
+
+            std::array<std::array<Entry, FeatureSet::RefreshBuckets>, 2> Entries;
+
+        public:
+            /// \brief Clears the cache.
+            /// \details All entries are reloaded with the bias the next time they are used.
+            inline void Clear()
+            {
+                for (std::array<Entry, FeatureSet::RefreshBuckets>& perspective : Entries)
+                    for (Entry& entry : perspective) entry.Loaded = false;
+            }
+
+            /// \brief Refreshes the accumulator of a perspective using the cache.
+            /// \tparam WeightSize The size of the feature weight array.
+            /// \param perspective The perspective to refresh (0 for white, 1 for black).
+            /// \param king The square of the perspective's own king.
+            /// \param bitboards The piece bitboards of the position, indexed by color and then piece.
+            /// \param weight The feature weight array.
+            /// \param bias The feature bias array.
+            /// \param accumulator The accumulator of the perspective to refresh.
+            /// \details The cached entry of the perspective's bucket is brought up to date with the position in a
+            ///          single pass over the accumulator, and then copied into the perspective's accumulator.
+            template<size_t WeightSize>
+            inline void Refresh(const uint8_t perspective, const uint8_t king, const uint64_t (&bitboards)[2][6],
+                                const std::array<T, WeightSize>& weight, const std::array<T, AccumulatorSize>& bias,
+                                std::array<T, AccumulatorSize>& accumulator)
+            {
+                Entry& entry = Entries[perspective][FeatureSet::RefreshBucket(perspective, king)];
+
+                // Load the bias into entries that haven't been used yet, which is the accumulator of an empty board:
+                if (!entry.Loaded) {
+                    std::copy(std::begin(bias), std::end(bias), std::begin(entry.Accumulator));
+                    for (std::array<uint64_t, PieceCount>& pieces : entry.Bitboards) pieces.fill(0);
+
+                    entry.Loaded = true;
+                }
+
+                // Collect the features that differ between the cached position and the new position:
+                std::array<uint32_t, MaxChanges> subtract;
+                std::array<uint32_t, MaxChanges> add     ;
+                size_t subtractCount = 0;
+                size_t addCount      = 0;
+
+                for (uint8_t color = 0; color < ColorCount; color++) {
+                    for (uint8_t piece = 0; piece < PieceCount; piece++) {
+                        const uint64_t cached = entry.Bitboards[color][piece];
+                        const uint64_t target = bitboards      [color][piece];
+
+                        for (uint64_t removed = cached & ~target; removed; removed &= removed - 1) {
+                            const auto sq = static_cast<uint8_t>(std::countr_zero(removed));
+                            subtract[subtractCount++] = FeatureSet::Index(perspective, piece, color, sq, king) *
+                                                        AccumulatorSize;
+                        }
+
+                        for (uint64_t added = target & ~cached; added; added &= added - 1) {
+                            const auto sq = static_cast<uint8_t>(std::countr_zero(added));
+                            add[addCount++] = FeatureSet::Index(perspective, piece, color, sq, king) *
+                                              AccumulatorSize;
+                        }
+
+                        entry.Bitboards[color][piece] = target;
+                    }
+                }
+
+                // Apply the difference to the cached entry, and copy the result into the accumulator:
+                SIMD::SubtractAndAddToAll(entry.Accumulator, entry.Accumulator, weight,
+                                          subtract, subtractCount, add, addCount);
+
+                std::copy(std::begin(entry.Accumulator), std::end(entry.Accumulator), std::begin(accumulator));
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_PERSPECTIVEREFRESHCACHE_H
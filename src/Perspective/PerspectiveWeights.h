@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2023 MantaRay authors. See the list of authors for more details.
+// Licensed under MIT.
+//
+
+#ifndef MANTARAY_PERSPECTIVEWEIGHTS_H
+#define MANTARAY_PERSPECTIVEWEIGHTS_H
+
+#include <array>
+#include <cstdint>
+#include <sstream>
+
+#include "../Backend/Dispatch.h"
+#include "../IO/BinaryFileStream.h"
+#include "../IO/BinaryMemoryStream.h"
+#include "../IO/MarlinflowStream.h"
+#include "../FeatureSet/Chess768.h"
+
+namespace MantaRay
+{
+
+    /// \brief The weights and biases of a Perspective-accounting Neural Network.
+    /// \tparam T The internal input layer type of the network. Currently only int16_t is supported.
+    /// \tparam OT The internal output layer type of the network. Currently only int32_t is supported.
+    /// \tparam InputSize The size of the input layer.
+    /// \tparam HiddenSize The size of the hidden layer.
+    /// \tparam OutputSize The size of the output layer.
+    /// \tparam QuantizationFeature The quantization factor of the input layer.
+    /// \tparam QuantizationOutput The quantization factor of the output layer.
+    /// \tparam FeatureSet The input feature set the weights were trained with. Defaults to MantaRay::Chess768.
+    /// \details This class holds the (permuted) weights and biases of a perspective-accounting neural network and
+    ///          nothing else. Once loaded, it is never written to during inference, so a single instance can be
+    ///          shared by any number of evaluators (for example, one per search thread) without each of them
+    ///          carrying its own copy of the feature transformer.
+    /// \see MantaRay::PerspectiveEvaluator for the per-thread state that references these weights.
+    template<typename T, typename OT, uint16_t InputSize, uint16_t HiddenSize, uint16_t OutputSize,
+            T QuantizationFeature, T QuantizationOutput, typename FeatureSet = Chess768>
+    class PerspectiveWeights
+    {
+
+        // Support more types in the future, but currently disable all others.
+        static_assert(std::is_same_v<T, int16_t> && std::is_same_v<OT, int32_t>,
+                "This type is currently not supported.");
+
+        // The input layer must be the size of the feature set.
+        static_assert(InputSize == FeatureSet::InputSize, "The input size does not match the feature set.");
+
+        // Support less sizes in the future, but currently disable.
+        static_assert(HiddenSize >= 32, "This network size is currently not supported.");
+
+        // The constants used should make sense. Change this later if requested.
+        static_assert(QuantizationFeature > 127 && QuantizationOutput > 31,
+                "These quantization constants don't seem right.");
+
+        public:
+#ifdef MANTARAY_AVX512
+            alignas(64) std::array<T, InputSize * HiddenSize     > FeatureWeight;
+            alignas(64) std::array<T, HiddenSize                 > FeatureBias  ;
+            alignas(64) std::array<T, HiddenSize * 2 * OutputSize> OutputWeight ;
+            alignas(64) std::array<T, OutputSize                 > OutputBias   ;
+#elifdef MANTARAY_AVX2
+            alignas(32) std::array<T, InputSize * HiddenSize     > FeatureWeight;
+            alignas(32) std::array<T, HiddenSize                 > FeatureBias  ;
+            alignas(32) std::array<T, HiddenSize * 2 * OutputSize> OutputWeight ;
+            alignas(32) std::array<T, OutputSize                 > OutputBias   ;
+#elifdef MANTARAY_SSE
+            alignas(16) std::array<T, InputSize * HiddenSize     > FeatureWeight;
+            alignas(16) std::array<T, HiddenSize                 > FeatureBias  ;
+            alignas(16) std::array<T, HiddenSize * 2 * OutputSize> OutputWeight ;
+            alignas(16) std::array<T, OutputSize                 > OutputBias   ;
+#else
+            std::array<T, InputSize * HiddenSize     > FeatureWeight;
+            std::array<T, HiddenSize                 > FeatureBias  ;
+            std::array<T, HiddenSize * 2 * OutputSize> OutputWeight ;
+            std::array<T, OutputSize                 > OutputBias   ;
+#endif
+
+            /// \brief Constructs a new PerspectiveWeights.
+            /// \details This constructor leaves the weights and biases undefined.
+            __attribute__((unused)) PerspectiveWeights() = default;
+
+            /// \brief Constructs a new PerspectiveWeights.
+            /// \param stream The binary file stream to read the weights from.
+            /// \details This constructor initializes the weights and biases read from the stream.
+            __attribute__((unused)) explicit PerspectiveWeights(BinaryFileStream &stream)
+            {
+                stream.ReadArray(FeatureWeight);
+                stream.ReadArray(FeatureBias  );
+                stream.ReadArray(OutputWeight );
+                stream.ReadArray(OutputBias   );
+            }
+
+            /// \brief Constructs a new PerspectiveWeights.
+            /// \param stream The binary memory stream to read the weights from.
+            /// \details This constructor initializes the weights and biases read from the stream.
+            __attribute__((unused)) explicit PerspectiveWeights(BinaryMemoryStream &stream)
+            {
+                stream.ReadArray(FeatureWeight);
+                stream.ReadArray(FeatureBias  );
+                stream.ReadArray(OutputWeight );
+                stream.ReadArray(OutputBias   );
+            }
+
+            /// \brief Constructs a new PerspectiveWeights.
+            /// \param stream The Marlinflow JSON stream to read the weights from.
+            /// \details This constructor initializes the weights and biases read from the stream. Internally, this
+            ///          constructor also quantizes the weights and biases. It also permutes the weights to ensure
+            ///          better performance with respect to the cache. This constructor is only there to ensure
+            ///          compatibility with the Marlinflow JSON network format.
+            __attribute__((unused)) explicit PerspectiveWeights(MarlinflowStream &stream)
+            {
+                stream.Read2DArray("ft.weight" , FeatureWeight, HiddenSize    , QuantizationFeature,
+                                   true );
+                stream.Read2DArray("out.weight", OutputWeight , HiddenSize * 2, QuantizationOutput ,
+                                   false);
+
+                stream.ReadArray("ft.bias" , FeatureBias, QuantizationFeature                     );
+                stream.ReadArray("out.bias", OutputBias , QuantizationFeature * QuantizationOutput);
+            }
+
+            /// \brief Provides information about the weights.
+            /// \return A string containing information about the weights.
+            /// \details This function provides information about the architecture the weights belong to, such as the
+            ///          layer sizes, the number of weights and biases, and the quantization constants.
+            __attribute__((unused)) std::string Info() const
+            {
+                std::stringstream ss;
+                ss << "(" << InputSize << "->" << HiddenSize << ")" << "x2" << "->" << OutputSize << std::endl;
+
+                ss << "Details:" << std::endl;
+                ss << " | " << "First  Layer Size    : " << InputSize                   << std::endl;
+                ss << " | " << "Hidden Layer Size    : " << HiddenSize                  << std::endl;
+                ss << " | " << "Output Layer Size    : " << OutputSize                  << std::endl;
+                ss << " | " << "Input ->Hidden Weight: " <<  InputSize *     HiddenSize << std::endl;
+                ss << " | " << "Hidden->Output Weight: " << HiddenSize * 2 * OutputSize << std::endl;
+                ss << " | " << "QuantizationFeature  : " << QuantizationFeature         << std::endl;
+                ss << " | " << "QuantizationOutput   : " << QuantizationOutput          << std::endl;
+                return ss.str();
+            }
+
+            /// \brief Writes the weights to a binary file stream.
+            /// \param stream The binary file stream to write the weights to.
+            /// \details This function writes the weights and biases to the stream.
+            __attribute__((unused)) void WriteTo(BinaryFileStream &stream) const
+            {
+                stream.WriteMode();
+
+                stream.WriteArray(FeatureWeight);
+                stream.WriteArray(FeatureBias  );
+                stream.WriteArray(OutputWeight );
+                stream.WriteArray(OutputBias   );
+            }
+
+    };
+
+} // MantaRay
+
+#endif //MANTARAY_PERSPECTIVEWEIGHTS_H
@@ -7,21 +7,76 @@
 #define MANTARAY_SIMD_H
 
 #include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
-#ifdef __AVX512BW__
+#include "Backend/Dispatch.h"
+
+#ifdef MANTARAY_AVX512_VNNI
+#include "Backend/Avx512Vnni.h"
+#endif
+
+#ifdef MANTARAY_AVX512
 #include "Backend/Avx512.h"
-#elifdef __AVX2__
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+#include "Backend/AvxVnni.h"
+#endif
+
+#ifdef MANTARAY_AVX2
 #include "Backend/Avx2.h"
 #endif
 
+#ifdef MANTARAY_SSE
+#include "Backend/Sse.h"
+#endif
+
+// Fully unrolls a loop over the registers of a tile, so the tile is kept in registers at every optimization level:
+#define MANTARAY_UNROLL _Pragma("GCC unroll 32")
+
 namespace MantaRay
 {
 
     /// \brief SIMD implementations for MantaRay.
-    /// \details This class contains SIMD implementations of common operations used in MantaRay.
+    /// \details This class contains SIMD implementations of common operations used in MantaRay. Every operation has
+    ///          an implementation per backend (taking the Target of its instruction set), and is called through the
+    ///          backend selected by MantaRay::Dispatch.
     class SIMD
     {
 
+        private:
+            /// \brief The indices of the set bits of every 8-bit mask, in ascending order and padded with zeros.
+            constexpr static std::array<std::array<uint16_t, 8>, 256> MaskIndices = [] {
+                std::array<std::array<uint16_t, 8>, 256> table {};
+
+                for (size_t mask = 0; mask < 256; mask++) {
+                    size_t count = 0;
+                    for (uint16_t bit = 0; bit < 8; bit++) if (mask & (1 << bit)) table[mask][count++] = bit;
+                }
+
+                return table;
+            }();
+
+            /// \brief The number of registers in a tile of an update.
+            /// \tparam RegisterCount The number of registers holding the whole array.
+            /// \tparam MaxTileSize The most registers a tile can hold, a power of two.
+            /// \return The largest power of two up to MaxTileSize dividing RegisterCount.
+            /// \details The tile is kept to half of the register file of the backend at most, leaving the rest to the
+            ///          delta loads and the compiler.
+            template<size_t RegisterCount, size_t MaxTileSize>
+            constexpr static size_t TileSize()
+            {
+                static_assert(RegisterCount > 0, "The array must fill at least one register.");
+
+                size_t size = MaxTileSize;
+                while (RegisterCount % size != 0) size /= 2;
+
+                return size;
+            }
+
         public:
             /// \brief Add the delta to elements in the input arrays.
             /// \tparam T The type of the input and delta.
@@ -39,81 +94,15 @@ namespace MantaRay
                                         const std::array<T, DeltaSize>& delta,
                                         const uint32_t oA, const uint32_t oB)
             {
-#ifdef __AVX512BW__
-                // Define the registers used in the loops:
-                Vec512I zmm0;
-                Vec512I zmm1;
-
-                // Define the step size for the loops:
-                constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
-
-                //region INPUT A
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    zmm0 = Avx512<T>::From(inputA,      i);
-                    zmm1 = Avx512<T>::From(delta , oA + i);
-
-                    // Add the delta register to the input register:
-                    zmm0 = Avx512<T>::Add(zmm0, zmm1);
-
-                    // Store the result back from the input register to the input array:
-                    Avx512<T>::Store(zmm0, inputA, i);
-                }
-                //endregion
-
-                //region INPUT B
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    zmm0 = Avx512<T>::From(inputB,      i);
-                    zmm1 = Avx512<T>::From(delta , oB + i);
-
-                    // Add the delta register to the input register:
-                    zmm0 = Avx512<T>::Add(zmm0, zmm1);
-
-                    // Store the result back from the input register to the input array:
-                    Avx512<T>::Store(zmm0, inputB, i);
-                }
-                //endregion
-#elifdef __AVX2__
-                // Define the registers used in the loops:
-                Vec256I ymm0;
-                Vec256I ymm1;
-
-                // Define the step size for the loops:
-                constexpr size_t Step = sizeof(Vec256I) / sizeof(T);
-
-                //region INPUT A
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    ymm0 = Avx<T> ::From(inputA,      i);
-                    ymm1 = Avx<T> ::From(delta , oA + i);
-
-                    // Add the delta register to the input register:
-                    ymm0 = Avx2<T>::Add(ymm0, ymm1);
-
-                    // Store the result back from the input register to the input array:
-                    Avx<T>::Store(ymm0, inputA, i);
-                }
-                //endregion
-
-                //region INPUT B
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    ymm0 = Avx<T> ::From(inputB,      i);
-                    ymm1 = Avx<T> ::From(delta , oB + i);
-
-                    // Add the delta register to the input register:
-                    ymm0 = Avx2<T>::Add(ymm0, ymm1);
-
-                    // Store the result back from the input register to the input array:
-                    Avx<T>::Store(ymm0, inputB, i);
-                }
-                //endregion
-#else
-                // Add the delta to the input arrays:
-                for (size_t i = 0; i < InputSize; i++) inputA[i] += delta[oA + i];
-                for (size_t i = 0; i < InputSize; i++) inputB[i] += delta[oB + i];
-#endif
+                // Define the delta offsets of both arrays, with no delta to subtract:
+                constexpr std::array<uint32_t, 0> none {};
+                const std::array<uint32_t, 1> addA = { oA };
+                const std::array<uint32_t, 1> addB = { oB };
+
+                Dispatch::Invoke([&](auto target) {
+                    SubtractAndAddToAll(target, inputA, inputA, delta, none, 0, addA, 1);
+                    SubtractAndAddToAll(target, inputB, inputB, delta, none, 0, addB, 1);
+                });
             }
 
             /// \brief Subtract the delta from elements in the input arrays.
@@ -132,81 +121,15 @@ namespace MantaRay
                                                const std::array<T, DeltaSize>& delta,
                                                const uint32_t oA, const uint32_t oB)
             {
-#ifdef __AVX512BW__
-                // Define the registers used in the loops:
-                Vec512I zmm0;
-                Vec512I zmm1;
-
-                // Define the step size for the loops:
-                constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
-
-                //region INPUT A
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    zmm0 = Avx512<T>::From(inputA,      i);
-                    zmm1 = Avx512<T>::From(delta , oA + i);
-
-                    // Subtract the delta register from the input register:
-                    zmm0 = Avx512<T>::Subtract(zmm0, zmm1);
-
-                    // Store the result back from the input register to the input array:
-                    Avx512<T>::Store(zmm0, inputA, i);
-                }
-                //endregion
-
-                //region INPUT B
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    zmm0 = Avx512<T>::From(inputB,      i);
-                    zmm1 = Avx512<T>::From(delta , oB + i);
-
-                    // Subtract the delta register from the input register:
-                    zmm0 = Avx512<T>::Subtract(zmm0, zmm1);
-
-                    // Store the result back from the input register to the input array:
-                    Avx512<T>::Store(zmm0, inputB, i);
-                }
-                //endregion
-#elifdef __AVX2__
-                // Define the registers used in the loops:
-                Vec256I ymm0;
-                Vec256I ymm1;
-
-                // Define the step size for the loops:
-                constexpr size_t Step = sizeof(Vec256I) / sizeof(T);
-
-                //region INPUT A
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    ymm0 = Avx<T> ::From(inputA,      i);
-                    ymm1 = Avx<T> ::From(delta , oA + i);
-
-                    // Subtract the delta register from the input register:
-                    ymm0 = Avx2<T>::Subtract(ymm0, ymm1);
-
-                    // Store the result back from the input register to the input array:
-                    Avx<T>::Store(ymm0, inputA, i);
-                }
-                //endregion
-
-                //region INPUT B
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    ymm0 = Avx<T> ::From(inputB,      i);
-                    ymm1 = Avx<T> ::From(delta , oB + i);
-
-                    // Subtract the delta register from the input register:
-                    ymm0 = Avx2<T>::Subtract(ymm0, ymm1);
-
-                    // Store the result back from the input register to the input array:
-                    Avx<T>::Store(ymm0, inputB, i);
-                }
-                //endregion
-#else
-                // Subtract the delta from the input arrays:
-                for (size_t i = 0; i < InputSize; i++) inputA[i] -= delta[oA + i];
-                for (size_t i = 0; i < InputSize; i++) inputB[i] -= delta[oB + i];
-#endif
+                // Define the delta offsets of both arrays, with no delta to add:
+                constexpr std::array<uint32_t, 0> none {};
+                const std::array<uint32_t, 1> subtractA = { oA };
+                const std::array<uint32_t, 1> subtractB = { oB };
+
+                Dispatch::Invoke([&](auto target) {
+                    SubtractAndAddToAll(target, inputA, inputA, delta, subtractA, 1, none, 0);
+                    SubtractAndAddToAll(target, inputB, inputB, delta, subtractB, 1, none, 0);
+                });
             }
 
             /// \brief Combination of SubtractFromAll and AddToAll.
@@ -230,235 +153,2841 @@ namespace MantaRay
                                                    const uint32_t oAS, const uint32_t oAA,
                                                    const uint32_t oBS, const uint32_t oBA)
             {
-#ifdef __AVX512BW__
-                // Define the registers used in the loops:
-                Vec512I zmm0;
-                Vec512I zmm1;
-                Vec512I zmm2;
-
-                // Define the step size for the loops:
-                constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
+                // Define the delta offsets of both arrays:
+                const std::array<uint32_t, 1> subtractA = { oAS };
+                const std::array<uint32_t, 1> addA      = { oAA };
+                const std::array<uint32_t, 1> subtractB = { oBS };
+                const std::array<uint32_t, 1> addB      = { oBA };
+
+                Dispatch::Invoke([&](auto target) {
+                    SubtractAndAddToAll(target, inputA, inputA, delta, subtractA, 1, addA, 1);
+                    SubtractAndAddToAll(target, inputB, inputB, delta, subtractB, 1, addB, 1);
+                });
+            }
 
-                //region INPUT A
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    zmm0 = Avx512<T>::From(inputA,       i);
-                    zmm1 = Avx512<T>::From(delta , oAS + i);
-                    zmm2 = Avx512<T>::From(delta , oAA + i);
+            /// \brief Subtract and add multiple deltas to elements in the input arrays in a single pass, storing the
+            ///        result in the output arrays.
+            /// \tparam SubtractCount The number of deltas to subtract.
+            /// \tparam AddCount The number of deltas to add.
+            /// \tparam T The type of the input, output, and delta.
+            /// \tparam InputSize The size of the input and output arrays.
+            /// \tparam DeltaSize The size of the delta array.
+            /// \param inputA The first input array.
+            /// \param inputB The second input array.
+            /// \param outputA The first output array.
+            /// \param outputB The second output array.
+            /// \param delta The delta array.
+            /// \param oAS The delta offsets for the first input array with respect to subtraction.
+            /// \param oAA The delta offsets for the first input array with respect to addition.
+            /// \param oBS The delta offsets for the second input array with respect to subtraction.
+            /// \param oBA The delta offsets for the second input array with respect to addition.
+            /// \details This function subtracts all subtraction deltas from, and adds all addition deltas to, elements
+            ///          in the input arrays, and stores the result in the output arrays. Every tile of the input arrays
+            ///          is loaded once, updated with all delta rows in registers, and stored once, so a capture
+            ///          (subtract, subtract, add) or castling (subtract, subtract, add, add) streams through the arrays
+            ///          a single time. The input and output arrays may be the same arrays to update in-place.
+            template<size_t SubtractCount, size_t AddCount, typename T, size_t InputSize, size_t DeltaSize>
+            static inline void SubtractAndAddToAll(const std::array<T, InputSize>& inputA,
+                                                   const std::array<T, InputSize>& inputB,
+                                                   std::array<T, InputSize>& outputA,
+                                                   std::array<T, InputSize>& outputB,
+                                                   const std::array<T, DeltaSize>& delta,
+                                                   const std::array<uint32_t, SubtractCount>& oAS,
+                                                   const std::array<uint32_t, AddCount     >& oAA,
+                                                   const std::array<uint32_t, SubtractCount>& oBS,
+                                                   const std::array<uint32_t, AddCount     >& oBA)
+            {
+                Dispatch::Invoke([&](auto target) {
+                    SubtractAndAddToAll(target, inputA, outputA, delta, oAS, SubtractCount, oAA, AddCount);
+                    SubtractAndAddToAll(target, inputB, outputB, delta, oBS, SubtractCount, oBA, AddCount);
+                });
+            }
 
-                    // Subtract and add the delta register to the input register:
-                    zmm0 = Avx512<T>::Subtract(zmm0, zmm1);
-                    zmm0 = Avx512<T>::Add(zmm0, zmm2);
+            /// \brief Subtract and add multiple deltas to elements in the input arrays in a single pass.
+            /// \tparam SubtractCount The number of deltas to subtract.
+            /// \tparam AddCount The number of deltas to add.
+            /// \tparam T The type of the input and delta.
+            /// \tparam InputSize The size of the input arrays.
+            /// \tparam DeltaSize The size of the delta array.
+            /// \param inputA The first input array.
+            /// \param inputB The second input array.
+            /// \param delta The delta array.
+            /// \param oAS The delta offsets for the first input array with respect to subtraction.
+            /// \param oAA The delta offsets for the first input array with respect to addition.
+            /// \param oBS The delta offsets for the second input array with respect to subtraction.
+            /// \param oBA The delta offsets for the second input array with respect to addition.
+            /// \details This function is the in-place variant of the multi-delta SubtractAndAddToAll.
+            template<size_t SubtractCount, size_t AddCount, typename T, size_t InputSize, size_t DeltaSize>
+            static inline void SubtractAndAddToAll(std::array<T, InputSize>& inputA, std::array<T, InputSize>& inputB,
+                                                   const std::array<T, DeltaSize>& delta,
+                                                   const std::array<uint32_t, SubtractCount>& oAS,
+                                                   const std::array<uint32_t, AddCount     >& oAA,
+                                                   const std::array<uint32_t, SubtractCount>& oBS,
+                                                   const std::array<uint32_t, AddCount     >& oBA)
+            {
+                SubtractAndAddToAll<SubtractCount, AddCount>(inputA, inputB, inputA, inputB, delta,
+                                                             oAS, oAA, oBS, oBA);
+            }
 
-                    // Store the result back from the input register to the input array:
-                    Avx512<T>::Store(zmm0, inputA, i);
-                }
-                //endregion
+            /// \brief Subtract and add a varying number of deltas to elements in the input array in a single pass,
+            ///        storing the result in the output array.
+            /// \tparam T The type of the input, output, and delta.
+            /// \tparam InputSize The size of the input and output arrays.
+            /// \tparam DeltaSize The size of the delta array.
+            /// \tparam SubtractCapacity The capacity of the subtraction offset array.
+            /// \tparam AddCapacity The capacity of the addition offset array.
+            /// \param input The input array.
+            /// \param output The output array.
+            /// \param delta The delta array.
+            /// \param oS The delta offsets with respect to subtraction.
+            /// \param subtractCount The number of deltas to subtract.
+            /// \param oA The delta offsets with respect to addition.
+            /// \param addCount The number of deltas to add.
+            /// \details This function updates a single array (one perspective) with an amount of deltas only known at
+            ///          runtime, such as the difference between two boards. It is the kernel behind every update: the
+            ///          input array is processed a tile of registers at a time, and every tile is loaded once, updated
+            ///          with all delta rows, and stored once. The tile holds as many registers as the backend can
+            ///          spare (up to half of its register file, see TileSize()) and is chosen at compile time, so
+            ///          accumulators of up to 512 (AVX-512), 128 (AVX2), or 64 (SSE4.1) 16-bit values are updated
+            ///          entirely in registers. The input and output arrays may be the same array to update in-place.
+            template<typename T, size_t InputSize, size_t DeltaSize, size_t SubtractCapacity, size_t AddCapacity>
+            static inline void SubtractAndAddToAll(const std::array<T, InputSize>& input,
+                                                   std::array<T, InputSize>& output,
+                                                   const std::array<T, DeltaSize>& delta,
+                                                   const std::array<uint32_t, SubtractCapacity>& oS,
+                                                   const size_t subtractCount,
+                                                   const std::array<uint32_t, AddCapacity>& oA,
+                                                   const size_t addCount)
+            {
+                Dispatch::Invoke([&](auto target) {
+                    SubtractAndAddToAll(target, input, output, delta, oS, subtractCount, oA, addCount);
+                });
+            }
 
-                //region INPUT B
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    zmm0 = Avx512<T>::From(inputB,       i);
-                    zmm1 = Avx512<T>::From(delta , oBS + i);
-                    zmm2 = Avx512<T>::From(delta , oBA + i);
+#ifdef MANTARAY_AVX512
+            /// \brief The AVX-512 implementation of SubtractAndAddToAll().
+            template<typename T, size_t InputSize, size_t DeltaSize, size_t SubtractCapacity, size_t AddCapacity>
+            MANTARAY_TARGET_AVX512
+            static inline void SubtractAndAddToAll(Target<InstructionSet::Avx512>,
+                                                   const std::array<T, InputSize>& input,
+                                                   std::array<T, InputSize>& output,
+                                                   const std::array<T, DeltaSize>& delta,
+                                                   const std::array<uint32_t, SubtractCapacity>& oS,
+                                                   const size_t subtractCount,
+                                                   const std::array<uint32_t, AddCapacity>& oA,
+                                                   const size_t addCount)
+            {
+                // Define the step size for the loop, and the number of registers in a tile:
+                constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
+                constexpr size_t Tile = TileSize<InputSize / Step, 16>();
+
+                // Define the registers holding a tile of the input array:
+                Vec512I tile[Tile];
+
+                for (size_t i = 0; i < InputSize; i += Step * Tile) {
+                    // Load the tile of the input array into the registers:
+                    MANTARAY_UNROLL
+                    for (size_t t = 0; t < Tile; t++) tile[t] = Avx512<T>::From(input, i + t * Step);
+
+                    // Subtract and add all delta rows to the tile (the registers of the tile are independent of each
+                    // other, so the updates of a delta row are all in flight at once):
+                    for (size_t s = 0; s < subtractCount; s++) {
+                        MANTARAY_UNROLL
+                        for (size_t t = 0; t < Tile; t++)
+                            tile[t] = Avx512<T>::Subtract(tile[t], Avx512<T>::From(delta, oS[s] + i + t * Step));
+                    }
 
-                    // Subtract and add the delta register to the input register:
-                    zmm0 = Avx512<T>::Subtract(zmm0, zmm1);
-                    zmm0 = Avx512<T>::Add(zmm0, zmm2);
+                    for (size_t a = 0; a < addCount; a++) {
+                        MANTARAY_UNROLL
+                        for (size_t t = 0; t < Tile; t++)
+                            tile[t] = Avx512<T>::Add     (tile[t], Avx512<T>::From(delta, oA[a] + i + t * Step));
+                    }
 
-                    // Store the result back from the input register to the input array:
-                    Avx512<T>::Store(zmm0, inputB, i);
+                    // Store the tile from the registers into the output array:
+                    MANTARAY_UNROLL
+                    for (size_t t = 0; t < Tile; t++) Avx512<T>::Store(tile[t], output, i + t * Step);
                 }
-                //endregion
-#elifdef __AVX2__
-                // Define the registers used in the loops:
-                Vec256I ymm0;
-                Vec256I ymm1;
-                Vec256I ymm2;
+            }
+#endif
 
-                // Define the step size for the loops:
+#ifdef MANTARAY_AVX2
+            /// \brief The AVX2 implementation of SubtractAndAddToAll().
+            template<typename T, size_t InputSize, size_t DeltaSize, size_t SubtractCapacity, size_t AddCapacity>
+            MANTARAY_TARGET_AVX2
+            static inline void SubtractAndAddToAll(Target<InstructionSet::Avx2>,
+                                                   const std::array<T, InputSize>& input,
+                                                   std::array<T, InputSize>& output,
+                                                   const std::array<T, DeltaSize>& delta,
+                                                   const std::array<uint32_t, SubtractCapacity>& oS,
+                                                   const size_t subtractCount,
+                                                   const std::array<uint32_t, AddCapacity>& oA,
+                                                   const size_t addCount)
+            {
+                // Define the step size for the loop, and the number of registers in a tile:
                 constexpr size_t Step = sizeof(Vec256I) / sizeof(T);
+                constexpr size_t Tile = TileSize<InputSize / Step, 8>();
+
+                // Define the registers holding a tile of the input array:
+                Vec256I tile[Tile];
+
+                for (size_t i = 0; i < InputSize; i += Step * Tile) {
+                    // Load the tile of the input array into the registers:
+                    MANTARAY_UNROLL
+                    for (size_t t = 0; t < Tile; t++) tile[t] = Avx<T>::From(input, i + t * Step);
+
+                    // Subtract and add all delta rows to the tile (the registers of the tile are independent of each
+                    // other, so the updates of a delta row are all in flight at once):
+                    for (size_t s = 0; s < subtractCount; s++) {
+                        MANTARAY_UNROLL
+                        for (size_t t = 0; t < Tile; t++)
+                            tile[t] = Avx2<T>::Subtract(tile[t], Avx<T>::From(delta, oS[s] + i + t * Step));
+                    }
 
-                //region INPUT A
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    ymm0 = Avx<T> ::From(inputA,       i);
-                    ymm1 = Avx<T> ::From(delta , oAS + i);
-                    ymm2 = Avx<T> ::From(delta , oAA + i);
-
-                    // Subtract and add the delta registers to the input register:
-                    ymm0 = Avx2<T>::Subtract(ymm0, ymm1);
-                    ymm0 = Avx2<T>::Add(ymm0, ymm2);
+                    for (size_t a = 0; a < addCount; a++) {
+                        MANTARAY_UNROLL
+                        for (size_t t = 0; t < Tile; t++)
+                            tile[t] = Avx2<T>::Add     (tile[t], Avx<T>::From(delta, oA[a] + i + t * Step));
+                    }
 
-                    // Store the result back from the input register to the input array:
-                    Avx<T>::Store(ymm0, inputA, i);
+                    // Store the tile from the registers into the output array:
+                    MANTARAY_UNROLL
+                    for (size_t t = 0; t < Tile; t++) Avx<T>::Store(tile[t], output, i + t * Step);
                 }
-                //endregion
+            }
+#endif
 
-                //region INPUT B
-                for (size_t i = 0; i < InputSize; i += Step) {
-                    // Load the input and delta values into the registers:
-                    ymm0 = Avx<T> ::From(inputB,       i);
-                    ymm1 = Avx<T> ::From(delta , oBS + i);
-                    ymm2 = Avx<T> ::From(delta , oBA + i);
+#ifdef MANTARAY_SSE
+            /// \brief The SSE4.1 implementation of SubtractAndAddToAll().
+            template<typename T, size_t InputSize, size_t DeltaSize, size_t SubtractCapacity, size_t AddCapacity>
+            MANTARAY_TARGET_SSE
+            static inline void SubtractAndAddToAll(Target<InstructionSet::Sse>,
+                                                   const std::array<T, InputSize>& input,
+                                                   std::array<T, InputSize>& output,
+                                                   const std::array<T, DeltaSize>& delta,
+                                                   const std::array<uint32_t, SubtractCapacity>& oS,
+                                                   const size_t subtractCount,
+                                                   const std::array<uint32_t, AddCapacity>& oA,
+                                                   const size_t addCount)
+            {
+                // Define the step size for the loop, and the number of registers in a tile:
+                constexpr size_t Step = sizeof(Vec128I) / sizeof(T);
+                constexpr size_t Tile = TileSize<InputSize / Step, 8>();
+
+                // Define the registers holding a tile of the input array:
+                Vec128I tile[Tile];
+
+                for (size_t i = 0; i < InputSize; i += Step * Tile) {
+                    // Load the tile of the input array into the registers:
+                    MANTARAY_UNROLL
+                    for (size_t t = 0; t < Tile; t++) tile[t] = Sse<T>::From(input, i + t * Step);
+
+                    // Subtract and add all delta rows to the tile (the registers of the tile are independent of each
+                    // other, so the updates of a delta row are all in flight at once):
+                    for (size_t s = 0; s < subtractCount; s++) {
+                        MANTARAY_UNROLL
+                        for (size_t t = 0; t < Tile; t++)
+                            tile[t] = Sse<T>::Subtract(tile[t], Sse<T>::From(delta, oS[s] + i + t * Step));
+                    }
 
-                    // Subtract and add the delta registers to the input register:
-                    ymm0 = Avx2<T>::Subtract(ymm0, ymm1);
-                    ymm0 = Avx2<T>::Add(ymm0, ymm2);
+                    for (size_t a = 0; a < addCount; a++) {
+                        MANTARAY_UNROLL
+                        for (size_t t = 0; t < Tile; t++)
+                            tile[t] = Sse<T>::Add     (tile[t], Sse<T>::From(delta, oA[a] + i + t * Step));
+                    }
 
-                    // Store the result back from the input register to the input array:
-                    Avx<T>::Store(ymm0, inputB, i);
+                    // Store the tile from the registers into the output array:
+                    MANTARAY_UNROLL
+                    for (size_t t = 0; t < Tile; t++) Sse<T>::Store(tile[t], output, i + t * Step);
                 }
-                //endregion
-#else
-                // Subtract and add the delta to the input arrays:
+            }
+#endif
+
+            /// \brief The scalar implementation of SubtractAndAddToAll().
+            template<typename T, size_t InputSize, size_t DeltaSize, size_t SubtractCapacity, size_t AddCapacity>
+            static inline void SubtractAndAddToAll(Target<InstructionSet::Scalar>,
+                                                   const std::array<T, InputSize>& input,
+                                                   std::array<T, InputSize>& output,
+                                                   const std::array<T, DeltaSize>& delta,
+                                                   const std::array<uint32_t, SubtractCapacity>& oS,
+                                                   const size_t subtractCount,
+                                                   const std::array<uint32_t, AddCapacity>& oA,
+                                                   const size_t addCount)
+            {
+                // Subtract and add all deltas to the input array, storing the result in the output array:
                 for (size_t i = 0; i < InputSize; i++) {
-                    inputA[i] = inputA[i] - delta[oAS + i] + delta[oAA + i];
-                    inputB[i] = inputB[i] - delta[oBS + i] + delta[oBA + i];
+                    T value = input[i];
+
+                    for (size_t s = 0; s < subtractCount; s++) value -= delta[oS[s] + i];
+                    for (size_t a = 0; a < addCount     ; a++) value += delta[oA[a] + i];
+
+                    output[i] = value;
                 }
-#endif
             }
 
             /// \brief Activate the input arrays, flatten the concatenated tensor result, and forward propagate the
-            ///        flattened result.
+            ///        flattened result for a single row of the weight array.
             /// \tparam Activation The activation function to use.
             /// \tparam T The type of the input, weight, and bias arrays.
-            /// \tparam OT The type of the output array.
+            /// \tparam OT The type of the output.
             /// \tparam InputSize The size of the input arrays.
-            /// \tparam OutputSize The size of the output array.
+            /// \tparam OutputSize The number of rows in the weight array.
             /// \param inputA The first input array.
             /// \param inputB The second input array.
             /// \param weight The weight array.
             /// \param bias The bias array.
-            /// \param output The output array.
-            /// \param o The offset into the output array.
-            /// \details This function activates the input arrays. Then it creates a Tensor-view of the input arrays,
-            ///          concatenating them vertically. After which, it flattens the vertical tensor into a 1D tensor.
-            ///          Finally, it forwards propagates the flattened tensor with respect to the weight and bias arrays
-            ///          using simple matrix multiplication. The result is stored in the output array starting at the
-            ///          given offset.
+            /// \param row The row of the weight array (and the element of the bias array) to forward propagate with.
+            /// \return The output of the row.
+            /// \details This function is equivalent to ActivateFlattenAndForward, but only computes a single output,
+            ///          reading only the weights of that output. This allows networks with multiple output buckets to
+            ///          evaluate as fast as networks with a single output. The activation provides the product of the
+            ///          activated input and the weight, which lets squared activations (such as SCReLU) fuse the square
+            ///          into the multiplication, and the divisor the sum is scaled down by before the bias is added.
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            static inline OT ActivateFlattenAndForwardRow(
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row)
+            {
+                return Dispatch::Invoke([&](auto target) {
+                    return ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA, inputB, weight, bias, row);
+                });
+            }
+
+#ifdef MANTARAY_AVX512_VNNI
+            /// \brief The AVX-512 VNNI implementation of ActivateFlattenAndForwardRow().
             template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
             [[clang::noinline]]
-            static void ActivateFlattenAndForward(
+            MANTARAY_TARGET_AVX512_VNNI
+            static OT ActivateFlattenAndForwardRow(
+                    Target<InstructionSet::Avx512Vnni>,
                     const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
                     const std::array<T, InputSize * 2 * OutputSize>& weight,
-                    const std::array<T, OutputSize>& bias,
-                    std::array<OT, OutputSize>& output, const uint32_t o)
+                    const std::array<T, OutputSize>& bias, const uint32_t row)
             {
                 // Define the stride with respect to the weight array:
-                size_t stride = 0;
+                const size_t stride = row * InputSize * 2;
+
+                // Define the step size for the loop, and the number of independent sum registers for each input:
+                constexpr size_t Step   = sizeof(Vec512I) / sizeof(T);
+                constexpr size_t Chains = TileSize<InputSize / Step, 4>();
 
                 // Perform the joint activation-flattening-forward propagation using matrix multiplication, defined as
                 // output = activation(flatten(input)) * weight + bias:
-                for (size_t i = 0; i < OutputSize; i++) {
-#ifdef __AVX512BW__
-                    // Define the register for sum accumulation:
-                    Vec512I zmm0 = Avx512<OT>::Zero();
-
-                    // Define the registers used in the inner loop:
-                    Vec512I zmm1;
-                    Vec512I zmm2;
+                // Define the registers for sum accumulation, a chain of them for each input, so that the accumulating
+                // multiply-adds (which have a long latency) don't wait on each other:
+                Vec512I sumA[Chains];
+                Vec512I sumB[Chains];
+
+                MANTARAY_UNROLL
+                for (size_t c = 0; c < Chains; c++) {
+                    sumA[c] = Avx512<OT>::Zero();
+                    sumB[c] = Avx512<OT>::Zero();
+                }
 
-                    // Define the step size for the loop:
-                    constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
+                // Define the registers used in the inner loop:
+                Vec512I zmm1;
+                Vec512I zmm2;
 
-                    // Inner loop performing sum += activation(flatten(input)) * weight:
-                    for (size_t j = 0; j < InputSize; j += Step) {
+                // Inner loop performing sum += activation(flatten(input)) * weight, interleaving both inputs:
+                for (size_t j = 0; j < InputSize; j += Step * Chains) {
+                    MANTARAY_UNROLL
+                    for (size_t c = 0; c < Chains; c++) {
                         //region INPUT A
                         // Load the input array and weight array into registers:
-                        zmm1 = Avx512<T> ::From(inputA, j);
-                        zmm2 = Avx512<T> ::From(weight, stride + j);
+                        zmm1 = Avx512<T>::From(inputA, j + c * Step);
+                        zmm2 = Avx512<T>::From(weight, stride + j + c * Step);
 
-                        // Activate the input register:
-                        zmm1 = Activation::Activate(zmm1);
-
-                        // Multiply the input register by the weight register and add the result to the sum register,
-                        // performing sum += input * weight:
-                        zmm1 = Avx512<T> ::MultiplyAndAddAdjacent(zmm1, zmm2);
-                        zmm0 = Avx512<OT>::Add(zmm0, zmm1);
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        sumA[c] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sumA[c], zmm1, zmm2);
                         //endregion
 
                         //region INPUT B
                         // Load the input array and weight array into registers:
-                        zmm1 = Avx512<T> ::From(inputB, j);
-                        zmm2 = Avx512<T> ::From(weight, InputSize + stride + j);
-
-                        // Activate the input register:
-                        zmm1 = Activation::Activate(zmm1);
+                        zmm1 = Avx512<T>::From(inputB, j + c * Step);
+                        zmm2 = Avx512<T>::From(weight, InputSize + stride + j + c * Step);
 
-                        // Multiply the input register by the weight register and add the result to the sum register,
-                        // performing sum += input * weight:
-                        zmm1 = Avx512<T> ::MultiplyAndAddAdjacent(zmm1, zmm2);
-                        zmm0 = Avx512<OT>::Add(zmm0, zmm1);
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        sumB[c] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sumB[c], zmm1, zmm2);
                         //endregion
                     }
+                }
+
+                // Add the chains of both inputs together, and sum up the remaining register only once:
+                MANTARAY_UNROLL
+                for (size_t c = 1; c < Chains; c++) {
+                    sumA[0] = Avx512<OT>::Add(sumA[0], sumA[c]);
+                    sumB[0] = Avx512<OT>::Add(sumB[0], sumB[c]);
+                }
 
-                    stride += InputSize * 2;
+                zmm1 = Avx512<OT>::Add(sumA[0], sumB[0]);
 
-                    output[o + i] = Avx512<OT>::Sum(zmm0) + bias[o + i];
-#elifdef __AVX2__
-                    // Define the register for sum accumulation:
-                    Vec256I ymm0 = Avx<OT>::Zero();
+                // Return the sum with respect to the bias:
+                return Avx512<OT>::Sum(zmm1) / Activation::Divisor + bias[row];
+            }
+#endif
+
+#ifdef MANTARAY_AVX512
+            /// \brief The AVX-512 implementation of ActivateFlattenAndForwardRow().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX512
+            static OT ActivateFlattenAndForwardRow(
+                    Target<InstructionSet::Avx512>,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Define the step size for the loop, and the number of independent sum registers for each input:
+                constexpr size_t Step   = sizeof(Vec512I) / sizeof(T);
+                constexpr size_t Chains = TileSize<InputSize / Step, 4>();
 
-                    // Define the registers used in the inner loop:
-                    Vec256I ymm1;
-                    Vec256I ymm2;
+                // Perform the joint activation-flattening-forward propagation using matrix multiplication, defined as
+                // output = activation(flatten(input)) * weight + bias:
+                // Define the registers for sum accumulation, a chain of them for each input, so that the additions
+                // don't wait on each other:
+                Vec512I sumA[Chains];
+                Vec512I sumB[Chains];
+
+                MANTARAY_UNROLL
+                for (size_t c = 0; c < Chains; c++) {
+                    sumA[c] = Avx512<OT>::Zero();
+                    sumB[c] = Avx512<OT>::Zero();
+                }
 
-                    // Define the step size for the loop:
-                    constexpr size_t Step = sizeof(Vec256I) / sizeof(T);
+                // Define the registers used in the inner loop:
+                Vec512I zmm1;
+                Vec512I zmm2;
 
-                    // Inner loop performing sum += activation(flatten(input)) * weight:
-                    for (size_t j = 0; j < InputSize; j += Step) {
+                // Inner loop performing sum += activation(flatten(input)) * weight, interleaving both inputs:
+                for (size_t j = 0; j < InputSize; j += Step * Chains) {
+                    MANTARAY_UNROLL
+                    for (size_t c = 0; c < Chains; c++) {
                         //region INPUT A
                         // Load the input array and weight array into registers:
-                        ymm1 = Avx<T>    ::From(inputA,          j);
-                        ymm2 = Avx<T>    ::From(weight, stride + j);
+                        zmm1 = Avx512<T>::From(inputA, j + c * Step);
+                        zmm2 = Avx512<T>::From(weight, stride + j + c * Step);
 
-                        // Activate the input register:
-                        ymm1 = Activation::Activate(ymm1);
-
-                        // Multiply the input register by the weight register and add the result to the sum register,
-                        // performing sum += input * weight:
-                        ymm1 = Avx2<T>   ::MultiplyAndAddAdjacent(ymm1, ymm2);
-                        ymm0 = Avx2<OT>  ::Add(ymm0, ymm1);
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        zmm1 = Activation::ActivateMultiplyAndAddAdjacent(zmm1, zmm2);
+                        sumA[c] = Avx512<OT>::Add(sumA[c], zmm1);
                         //endregion
 
                         //region INPUT B
                         // Load the input array and weight array into registers:
-                        ymm1 = Avx<T>    ::From(inputB,                      j);
-                        ymm2 = Avx<T>    ::From(weight, InputSize + stride + j);
-
-                        // Activate the input register:
-                        ymm1 = Activation::Activate(ymm1);
+                        zmm1 = Avx512<T>::From(inputB, j + c * Step);
+                        zmm2 = Avx512<T>::From(weight, InputSize + stride + j + c * Step);
 
-                        // Multiply the input register by the weight register and add the result to the sum register,
-                        // performing sum += input * weight:
-                        ymm1 = Avx2<T>   ::MultiplyAndAddAdjacent(ymm1, ymm2);
-                        ymm0 = Avx2<OT>  ::Add(ymm0, ymm1);
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        zmm1 = Activation::ActivateMultiplyAndAddAdjacent(zmm1, zmm2);
+                        sumB[c] = Avx512<OT>::Add(sumB[c], zmm1);
                         //endregion
                     }
+                }
+
+                // Add the chains of both inputs together, and sum up the remaining register only once:
+                MANTARAY_UNROLL
+                for (size_t c = 1; c < Chains; c++) {
+                    sumA[0] = Avx512<OT>::Add(sumA[0], sumA[c]);
+                    sumB[0] = Avx512<OT>::Add(sumB[0], sumB[c]);
+                }
 
-                    // Stride to the next set of weights:
-                    stride += InputSize * 2;
+                zmm1 = Avx512<OT>::Add(sumA[0], sumB[0]);
 
-                    // Sum up the sum accumulation register and store the result with respect to the bias:
-                    output[o + i] = Avx2<OT>::Sum(ymm0) + bias[o + i];
-#else
-                    // Define the sum accumulation variable:
-                    OT sum = 0;
+                // Return the sum with respect to the bias:
+                return Avx512<OT>::Sum(zmm1) / Activation::Divisor + bias[row];
+            }
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+            /// \brief The AVX-VNNI implementation of ActivateFlattenAndForwardRow().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX_VNNI
+            static OT ActivateFlattenAndForwardRow(
+                    Target<InstructionSet::AvxVnni>,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Define the step size for the loop, and the number of independent sum registers for each input:
+                constexpr size_t Step   = sizeof(Vec256I) / sizeof(T);
+                constexpr size_t Chains = TileSize<InputSize / Step, 4>();
+
+                // Perform the joint activation-flattening-forward propagation using matrix multiplication, defined as
+                // output = activation(flatten(input)) * weight + bias:
+                // Define the registers for sum accumulation, a chain of them for each input, so that the accumulating
+                // multiply-adds (which have a long latency) don't wait on each other:
+                Vec256I sumA[Chains];
+                Vec256I sumB[Chains];
+
+                MANTARAY_UNROLL
+                for (size_t c = 0; c < Chains; c++) {
+                    sumA[c] = Avx<OT>::Zero();
+                    sumB[c] = Avx<OT>::Zero();
+                }
+
+                // Define the registers used in the inner loop:
+                Vec256I ymm1;
+                Vec256I ymm2;
+
+                // Inner loop performing sum += activation(flatten(input)) * weight, interleaving both inputs:
+                for (size_t j = 0; j < InputSize; j += Step * Chains) {
+                    MANTARAY_UNROLL
+                    for (size_t c = 0; c < Chains; c++) {
+                        //region INPUT A
+                        // Load the input array and weight array into registers:
+                        ymm1 = Avx<T>::From(inputA, j + c * Step);
+                        ymm2 = Avx<T>::From(weight, stride + j + c * Step);
+
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        sumA[c] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sumA[c], ymm1, ymm2);
+                        //endregion
+
+                        //region INPUT B
+                        // Load the input array and weight array into registers:
+                        ymm1 = Avx<T>::From(inputB, j + c * Step);
+                        ymm2 = Avx<T>::From(weight, InputSize + stride + j + c * Step);
 
-                    for (size_t j = 0; j < InputSize; j++) {
-                        // Add the activation of the input multiplied by the weight to the sum:
-                        sum += Activation::Activate(inputA[j]) * weight[stride + j];
-                        sum += Activation::Activate(inputB[j]) * weight[InputSize + stride + j];
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        sumB[c] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sumB[c], ymm1, ymm2);
+                        //endregion
                     }
+                }
 
-                    // Stride to the next set of weights:
-                    stride += InputSize * 2;
+                // Add the chains of both inputs together, and sum up the remaining register only once:
+                MANTARAY_UNROLL
+                for (size_t c = 1; c < Chains; c++) {
+                    sumA[0] = Avx2<OT>::Add(sumA[0], sumA[c]);
+                    sumB[0] = Avx2<OT>::Add(sumB[0], sumB[c]);
+                }
 
-                    // Store the sum with respect to the bias:
-                    output[o + i] = sum + bias[o + i];
+                ymm1 = Avx2<OT>::Add(sumA[0], sumB[0]);
+
+                // Return the sum with respect to the bias:
+                return Avx2<OT>::Sum(ymm1) / Activation::Divisor + bias[row];
+            }
 #endif
+
+#ifdef MANTARAY_AVX2
+            /// \brief The AVX2 implementation of ActivateFlattenAndForwardRow().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX2
+            static OT ActivateFlattenAndForwardRow(
+                    Target<InstructionSet::Avx2>,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Define the step size for the loop, and the number of independent sum registers for each input:
+                constexpr size_t Step   = sizeof(Vec256I) / sizeof(T);
+                constexpr size_t Chains = TileSize<InputSize / Step, 4>();
+
+                // Perform the joint activation-flattening-forward propagation using matrix multiplication, defined as
+                // output = activation(flatten(input)) * weight + bias:
+                // Define the registers for sum accumulation, a chain of them for each input, so that the additions
+                // don't wait on each other:
+                Vec256I sumA[Chains];
+                Vec256I sumB[Chains];
+
+                MANTARAY_UNROLL
+                for (size_t c = 0; c < Chains; c++) {
+                    sumA[c] = Avx<OT>::Zero();
+                    sumB[c] = Avx<OT>::Zero();
+                }
+
+                // Define the registers used in the inner loop:
+                Vec256I ymm1;
+                Vec256I ymm2;
+
+                // Inner loop performing sum += activation(flatten(input)) * weight, interleaving both inputs:
+                for (size_t j = 0; j < InputSize; j += Step * Chains) {
+                    MANTARAY_UNROLL
+                    for (size_t c = 0; c < Chains; c++) {
+                        //region INPUT A
+                        // Load the input array and weight array into registers:
+                        ymm1 = Avx<T>::From(inputA, j + c * Step);
+                        ymm2 = Avx<T>::From(weight, stride + j + c * Step);
+
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        ymm1 = Activation::ActivateMultiplyAndAddAdjacent(ymm1, ymm2);
+                        sumA[c] = Avx2<OT>::Add(sumA[c], ymm1);
+                        //endregion
+
+                        //region INPUT B
+                        // Load the input array and weight array into registers:
+                        ymm1 = Avx<T>::From(inputB, j + c * Step);
+                        ymm2 = Avx<T>::From(weight, InputSize + stride + j + c * Step);
+
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        ymm1 = Activation::ActivateMultiplyAndAddAdjacent(ymm1, ymm2);
+                        sumB[c] = Avx2<OT>::Add(sumB[c], ymm1);
+                        //endregion
+                    }
+                }
+
+                // Add the chains of both inputs together, and sum up the remaining register only once:
+                MANTARAY_UNROLL
+                for (size_t c = 1; c < Chains; c++) {
+                    sumA[0] = Avx2<OT>::Add(sumA[0], sumA[c]);
+                    sumB[0] = Avx2<OT>::Add(sumB[0], sumB[c]);
+                }
+
+                ymm1 = Avx2<OT>::Add(sumA[0], sumB[0]);
+
+                // Return the sum with respect to the bias:
+                return Avx2<OT>::Sum(ymm1) / Activation::Divisor + bias[row];
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            /// \brief The SSE4.1 implementation of ActivateFlattenAndForwardRow().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_SSE
+            static OT ActivateFlattenAndForwardRow(
+                    Target<InstructionSet::Sse>,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Define the step size for the loop, and the number of independent sum registers for each input:
+                constexpr size_t Step   = sizeof(Vec128I) / sizeof(T);
+                constexpr size_t Chains = TileSize<InputSize / Step, 4>();
+
+                // Perform the joint activation-flattening-forward propagation using matrix multiplication, defined as
+                // output = activation(flatten(input)) * weight + bias:
+                // Define the registers for sum accumulation, a chain of them for each input, so that the additions
+                // don't wait on each other:
+                Vec128I sumA[Chains];
+                Vec128I sumB[Chains];
+
+                MANTARAY_UNROLL
+                for (size_t c = 0; c < Chains; c++) {
+                    sumA[c] = Sse<OT>::Zero();
+                    sumB[c] = Sse<OT>::Zero();
+                }
+
+                // Define the registers used in the inner loop:
+                Vec128I xmm1;
+                Vec128I xmm2;
+
+                // Inner loop performing sum += activation(flatten(input)) * weight, interleaving both inputs:
+                for (size_t j = 0; j < InputSize; j += Step * Chains) {
+                    MANTARAY_UNROLL
+                    for (size_t c = 0; c < Chains; c++) {
+                        //region INPUT A
+                        // Load the input array and weight array into registers:
+                        xmm1 = Sse<T>::From(inputA, j + c * Step);
+                        xmm2 = Sse<T>::From(weight, stride + j + c * Step);
+
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        xmm1 = Activation::ActivateMultiplyAndAddAdjacent(xmm1, xmm2);
+                        sumA[c] = Sse<OT>::Add(sumA[c], xmm1);
+                        //endregion
+
+                        //region INPUT B
+                        // Load the input array and weight array into registers:
+                        xmm1 = Sse<T>::From(inputB, j + c * Step);
+                        xmm2 = Sse<T>::From(weight, InputSize + stride + j + c * Step);
+
+                        // Activate the input register, multiply it by the weight register, and add the result to the
+                        // sum register of the chain, performing sum += activation(input) * weight:
+                        xmm1 = Activation::ActivateMultiplyAndAddAdjacent(xmm1, xmm2);
+                        sumB[c] = Sse<OT>::Add(sumB[c], xmm1);
+                        //endregion
+                    }
+                }
+
+                // Add the chains of both inputs together, and sum up the remaining register only once:
+                MANTARAY_UNROLL
+                for (size_t c = 1; c < Chains; c++) {
+                    sumA[0] = Sse<OT>::Add(sumA[0], sumA[c]);
+                    sumB[0] = Sse<OT>::Add(sumB[0], sumB[c]);
+                }
+
+                xmm1 = Sse<OT>::Add(sumA[0], sumB[0]);
+
+                // Return the sum with respect to the bias:
+                return Sse<OT>::Sum(xmm1) / Activation::Divisor + bias[row];
+            }
+#endif
+
+            /// \brief The scalar implementation of ActivateFlattenAndForwardRow().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            static OT ActivateFlattenAndForwardRow(
+                    Target<InstructionSet::Scalar>,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Perform the joint activation-flattening-forward propagation using matrix multiplication, defined as
+                // output = activation(flatten(input)) * weight + bias:
+                // Define the sum accumulation variable:
+                OT sum = 0;
+
+                for (size_t j = 0; j < InputSize; j++) {
+                    // Add the activation of the input multiplied by the weight to the sum:
+                    sum += Activation::ActivateAndMultiply(inputA[j], weight[stride + j]);
+                    sum += Activation::ActivateAndMultiply(inputB[j], weight[InputSize + stride + j]);
+                }
+
+                // Return the sum with respect to the bias:
+                return sum / Activation::Divisor + bias[row];
+            }
+
+            /// \brief Activate the input arrays, flatten the concatenated tensor result, and forward propagate the
+            ///        flattened result.
+            /// \tparam Activation The activation function to use.
+            /// \tparam T The type of the input, weight, and bias arrays.
+            /// \tparam OT The type of the output array.
+            /// \tparam InputSize The size of the input arrays.
+            /// \tparam OutputSize The size of the output array.
+            /// \param inputA The first input array.
+            /// \param inputB The second input array.
+            /// \param weight The weight array.
+            /// \param bias The bias array.
+            /// \param output The output array.
+            /// \param o The offset into the output array.
+            /// \details This function activates the input arrays. Then it creates a Tensor-view of the input arrays,
+            ///          concatenating them vertically. After which, it flattens the vertical tensor into a 1D tensor.
+            ///          Finally, it forwards propagates the flattened tensor with respect to the weight and bias arrays
+            ///          using simple matrix multiplication. The result is stored in the output array starting at the
+            ///          given offset.
+            ///
+            ///          The outputs are computed in groups of one output for every 32-bit value of a register, so that
+            ///          every input register is loaded and activated once for the whole group, and the sum registers
+            ///          of the group are summed up together into a single register of outputs instead of one
+            ///          horizontal addition for every output.
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            static inline void ActivateFlattenAndForward(
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias,
+                    std::array<OT, OutputSize>& output, const uint32_t o)
+            {
+                Dispatch::Invoke([&](auto target) {
+                    ActivateFlattenAndForward<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA, inputB, weight, bias, output, o);
+                });
+            }
+
+#ifdef MANTARAY_AVX512_VNNI
+            /// \brief The AVX-512 VNNI implementation of ActivateFlattenAndForward().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX512_VNNI
+            static void ActivateFlattenAndForward(
+                    const Target<InstructionSet::Avx512Vnni> target,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias,
+                    std::array<OT, OutputSize>& output, const uint32_t o)
+            {
+                // Define the registers used in the inner loop:
+                Vec512I zmm1;
+                Vec512I zmm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec512I) / sizeof(OT);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, activating every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec512I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(64) std::array<OT, Group> sum;
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx512<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every output of the
+                        // group, interleaving both inputs:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            //region INPUT A
+                            // Load the input array into a register:
+                            zmm1 = Avx512<T>::From(inputA, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                zmm2 = Avx512<T>::From(weight, (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                sums[g] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sums[g], zmm1, zmm2);
+                            }
+                            //endregion
+
+                            //region INPUT B
+                            // Load the input array into a register:
+                            zmm1 = Avx512<T>::From(inputB, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                zmm2 = Avx512<T>::From(weight, InputSize + (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                sums[g] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sums[g], zmm1, zmm2);
+                            }
+                            //endregion
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Avx512<OT>::Store(Avx512<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[o + i + g] = sum[g] / Activation::Divisor + bias[i + g];
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++)
+                    output[o + i] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA, inputB, weight, bias, i);
+            }
+#endif
+
+#ifdef MANTARAY_AVX512
+            /// \brief The AVX-512 implementation of ActivateFlattenAndForward().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX512
+            static void ActivateFlattenAndForward(
+                    const Target<InstructionSet::Avx512> target,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias,
+                    std::array<OT, OutputSize>& output, const uint32_t o)
+            {
+                // Define the registers used in the inner loop:
+                Vec512I zmm1;
+                Vec512I zmm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec512I) / sizeof(OT);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, activating every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec512I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(64) std::array<OT, Group> sum;
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx512<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every output of the
+                        // group, interleaving both inputs:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            //region INPUT A
+                            // Load the input array into a register:
+                            zmm1 = Avx512<T>::From(inputA, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                zmm2 = Avx512<T>::From(weight, (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                zmm2 = Activation::ActivateMultiplyAndAddAdjacent(zmm1, zmm2);
+                                sums[g] = Avx512<OT>::Add(sums[g], zmm2);
+                            }
+                            //endregion
+
+                            //region INPUT B
+                            // Load the input array into a register:
+                            zmm1 = Avx512<T>::From(inputB, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                zmm2 = Avx512<T>::From(weight, InputSize + (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                zmm2 = Activation::ActivateMultiplyAndAddAdjacent(zmm1, zmm2);
+                                sums[g] = Avx512<OT>::Add(sums[g], zmm2);
+                            }
+                            //endregion
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Avx512<OT>::Store(Avx512<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[o + i + g] = sum[g] / Activation::Divisor + bias[i + g];
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++)
+                    output[o + i] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA, inputB, weight, bias, i);
+            }
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+            /// \brief The AVX-VNNI implementation of ActivateFlattenAndForward().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX_VNNI
+            static void ActivateFlattenAndForward(
+                    const Target<InstructionSet::AvxVnni> target,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias,
+                    std::array<OT, OutputSize>& output, const uint32_t o)
+            {
+                // Define the registers used in the inner loop:
+                Vec256I ymm1;
+                Vec256I ymm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec256I) / sizeof(T);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec256I) / sizeof(OT);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, activating every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec256I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(32) std::array<OT, Group> sum;
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every output of the
+                        // group, interleaving both inputs:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            //region INPUT A
+                            // Load the input array into a register:
+                            ymm1 = Avx<T>::From(inputA, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                ymm2 = Avx<T>::From(weight, (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                sums[g] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sums[g], ymm1, ymm2);
+                            }
+                            //endregion
+
+                            //region INPUT B
+                            // Load the input array into a register:
+                            ymm1 = Avx<T>::From(inputB, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                ymm2 = Avx<T>::From(weight, InputSize + (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                sums[g] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sums[g], ymm1, ymm2);
+                            }
+                            //endregion
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Avx<OT>::Store(Avx2<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[o + i + g] = sum[g] / Activation::Divisor + bias[i + g];
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++)
+                    output[o + i] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA, inputB, weight, bias, i);
+            }
+#endif
+
+#ifdef MANTARAY_AVX2
+            /// \brief The AVX2 implementation of ActivateFlattenAndForward().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX2
+            static void ActivateFlattenAndForward(
+                    const Target<InstructionSet::Avx2> target,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias,
+                    std::array<OT, OutputSize>& output, const uint32_t o)
+            {
+                // Define the registers used in the inner loop:
+                Vec256I ymm1;
+                Vec256I ymm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec256I) / sizeof(T);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec256I) / sizeof(OT);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, activating every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec256I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(32) std::array<OT, Group> sum;
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every output of the
+                        // group, interleaving both inputs:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            //region INPUT A
+                            // Load the input array into a register:
+                            ymm1 = Avx<T>::From(inputA, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                ymm2 = Avx<T>::From(weight, (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                ymm2 = Activation::ActivateMultiplyAndAddAdjacent(ymm1, ymm2);
+                                sums[g] = Avx2<OT>::Add(sums[g], ymm2);
+                            }
+                            //endregion
+
+                            //region INPUT B
+                            // Load the input array into a register:
+                            ymm1 = Avx<T>::From(inputB, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                ymm2 = Avx<T>::From(weight, InputSize + (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                ymm2 = Activation::ActivateMultiplyAndAddAdjacent(ymm1, ymm2);
+                                sums[g] = Avx2<OT>::Add(sums[g], ymm2);
+                            }
+                            //endregion
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Avx<OT>::Store(Avx2<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[o + i + g] = sum[g] / Activation::Divisor + bias[i + g];
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++)
+                    output[o + i] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA, inputB, weight, bias, i);
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            /// \brief The SSE4.1 implementation of ActivateFlattenAndForward().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_SSE
+            static void ActivateFlattenAndForward(
+                    const Target<InstructionSet::Sse> target,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias,
+                    std::array<OT, OutputSize>& output, const uint32_t o)
+            {
+                // Define the registers used in the inner loop:
+                Vec128I xmm1;
+                Vec128I xmm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec128I) / sizeof(T);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec128I) / sizeof(OT);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, activating every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec128I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(16) std::array<OT, Group> sum;
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Sse<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every output of the
+                        // group, interleaving both inputs:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            //region INPUT A
+                            // Load the input array into a register:
+                            xmm1 = Sse<T>::From(inputA, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                xmm2 = Sse<T>::From(weight, (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                xmm2 = Activation::ActivateMultiplyAndAddAdjacent(xmm1, xmm2);
+                                sums[g] = Sse<OT>::Add(sums[g], xmm2);
+                            }
+                            //endregion
+
+                            //region INPUT B
+                            // Load the input array into a register:
+                            xmm1 = Sse<T>::From(inputB, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                xmm2 = Sse<T>::From(weight, InputSize + (i + g) * InputSize * 2 + j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the output:
+                                xmm2 = Activation::ActivateMultiplyAndAddAdjacent(xmm1, xmm2);
+                                sums[g] = Sse<OT>::Add(sums[g], xmm2);
+                            }
+                            //endregion
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Sse<OT>::Store(Sse<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[o + i + g] = sum[g] / Activation::Divisor + bias[i + g];
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++)
+                    output[o + i] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA, inputB, weight, bias, i);
+            }
+#endif
+
+            /// \brief The scalar implementation of ActivateFlattenAndForward().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            static void ActivateFlattenAndForward(
+                    const Target<InstructionSet::Scalar> target,
+                    const std::array<T, InputSize>& inputA, const std::array<T, InputSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias,
+                    std::array<OT, OutputSize>& output, const uint32_t o)
+            {
+                // Forward propagate every row of the weight array:
+                for (size_t i = 0; i < OutputSize; i++)
+                    output[o + i] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA, inputB, weight, bias, i);
+            }
+
+            /// \brief Activate the input arrays of a batch of positions, flatten the concatenated tensor results, and
+            ///        forward propagate the flattened results for a single row of the weight array.
+            /// \tparam Activation The activation function to use.
+            /// \tparam T The type of the input, weight, and bias arrays.
+            /// \tparam OT The type of the output.
+            /// \tparam InputSize The size of the input arrays.
+            /// \tparam OutputSize The number of rows in the weight array.
+            /// \tparam BatchSize The number of positions in the batch.
+            /// \param inputA The first input array of every position.
+            /// \param inputB The second input array of every position.
+            /// \param weight The weight array.
+            /// \param bias The bias array.
+            /// \param row The row of the weight array (and the element of the bias array) to forward propagate with.
+            /// \param output The output array, holding the output of every position.
+            /// \details This function is equivalent to calling ActivateFlattenAndForwardRow() for every position of the
+            ///          batch, but multiplies the positions with the weights like a matrix multiplication: the
+            ///          positions are computed in groups of one position for every 32-bit value of a register, so that
+            ///          every weight register is loaded once for the whole group, and the sum registers of the group
+            ///          are summed up together into a single register of outputs.
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize,
+                    size_t BatchSize>
+            static inline void ActivateFlattenAndForwardBatch(
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputA,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row,
+                    std::array<OT, BatchSize>& output)
+            {
+                Dispatch::Invoke([&](auto target) {
+                    ActivateFlattenAndForwardBatch<Activation, T, OT, InputSize, OutputSize, BatchSize>(
+                            target, inputA, inputB, weight, bias, row, output);
+                });
+            }
+
+#ifdef MANTARAY_AVX512_VNNI
+            /// \brief The AVX-512 VNNI implementation of ActivateFlattenAndForwardBatch().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize,
+                    size_t BatchSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX512_VNNI
+            static void ActivateFlattenAndForwardBatch(
+                    const Target<InstructionSet::Avx512Vnni> target,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputA,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row,
+                    std::array<OT, BatchSize>& output)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Define the registers used in the inner loop:
+                Vec512I zmm0;
+                Vec512I zmm1;
+                Vec512I zmm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
+
+                // Define the number of positions propagated together (one for every 32-bit value of a register), and
+                // the number of positions in whole groups:
+                constexpr size_t Group   = sizeof(Vec512I) / sizeof(OT);
+                constexpr size_t Grouped = BatchSize / Group * Group;
+
+                // Forward propagate the whole groups of positions, loading every weight register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every position of the group:
+                    Vec512I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(64) std::array<OT, Group> sum;
+
+                    for (size_t b = 0; b < Grouped; b += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx512<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every position of the
+                        // group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the weight array of both inputs into registers:
+                            zmm1 = Avx512<T>::From(weight, stride + j);
+                            zmm2 = Avx512<T>::From(weight, InputSize + stride + j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                //region INPUT A
+                                // Load the input array of the position into a register:
+                                zmm0 = Avx512<T>::From(inputA[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                sums[g] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sums[g], zmm0, zmm1);
+                                //endregion
+
+                                //region INPUT B
+                                // Load the input array of the position into a register:
+                                zmm0 = Avx512<T>::From(inputB[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                sums[g] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sums[g], zmm0, zmm2);
+                                //endregion
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Avx512<OT>::Store(Avx512<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[b + g] = sum[g] / Activation::Divisor + bias[row];
+                    }
+                }
+
+                // Forward propagate the remaining positions one at a time:
+                for (size_t b = Grouped; b < BatchSize; b++)
+                    output[b] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA[b], inputB[b], weight, bias, row);
+            }
+#endif
+
+#ifdef MANTARAY_AVX512
+            /// \brief The AVX-512 implementation of ActivateFlattenAndForwardBatch().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize,
+                    size_t BatchSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX512
+            static void ActivateFlattenAndForwardBatch(
+                    const Target<InstructionSet::Avx512> target,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputA,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row,
+                    std::array<OT, BatchSize>& output)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Define the registers used in the inner loop:
+                Vec512I zmm0;
+                Vec512I zmm1;
+                Vec512I zmm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
+
+                // Define the number of positions propagated together (one for every 32-bit value of a register), and
+                // the number of positions in whole groups:
+                constexpr size_t Group   = sizeof(Vec512I) / sizeof(OT);
+                constexpr size_t Grouped = BatchSize / Group * Group;
+
+                // Forward propagate the whole groups of positions, loading every weight register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every position of the group:
+                    Vec512I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(64) std::array<OT, Group> sum;
+
+                    for (size_t b = 0; b < Grouped; b += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx512<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every position of the
+                        // group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the weight array of both inputs into registers:
+                            zmm1 = Avx512<T>::From(weight, stride + j);
+                            zmm2 = Avx512<T>::From(weight, InputSize + stride + j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                //region INPUT A
+                                // Load the input array of the position into a register:
+                                zmm0 = Avx512<T>::From(inputA[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                zmm0 = Activation::ActivateMultiplyAndAddAdjacent(zmm0, zmm1);
+                                sums[g] = Avx512<OT>::Add(sums[g], zmm0);
+                                //endregion
+
+                                //region INPUT B
+                                // Load the input array of the position into a register:
+                                zmm0 = Avx512<T>::From(inputB[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                zmm0 = Activation::ActivateMultiplyAndAddAdjacent(zmm0, zmm2);
+                                sums[g] = Avx512<OT>::Add(sums[g], zmm0);
+                                //endregion
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Avx512<OT>::Store(Avx512<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[b + g] = sum[g] / Activation::Divisor + bias[row];
+                    }
+                }
+
+                // Forward propagate the remaining positions one at a time:
+                for (size_t b = Grouped; b < BatchSize; b++)
+                    output[b] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA[b], inputB[b], weight, bias, row);
+            }
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+            /// \brief The AVX-VNNI implementation of ActivateFlattenAndForwardBatch().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize,
+                    size_t BatchSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX_VNNI
+            static void ActivateFlattenAndForwardBatch(
+                    const Target<InstructionSet::AvxVnni> target,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputA,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row,
+                    std::array<OT, BatchSize>& output)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Define the registers used in the inner loop:
+                Vec256I ymm0;
+                Vec256I ymm1;
+                Vec256I ymm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec256I) / sizeof(T);
+
+                // Define the number of positions propagated together (one for every 32-bit value of a register), and
+                // the number of positions in whole groups:
+                constexpr size_t Group   = sizeof(Vec256I) / sizeof(OT);
+                constexpr size_t Grouped = BatchSize / Group * Group;
+
+                // Forward propagate the whole groups of positions, loading every weight register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every position of the group:
+                    Vec256I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(32) std::array<OT, Group> sum;
+
+                    for (size_t b = 0; b < Grouped; b += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every position of the
+                        // group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the weight array of both inputs into registers:
+                            ymm1 = Avx<T>::From(weight, stride + j);
+                            ymm2 = Avx<T>::From(weight, InputSize + stride + j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                //region INPUT A
+                                // Load the input array of the position into a register:
+                                ymm0 = Avx<T>::From(inputA[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                sums[g] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sums[g], ymm0, ymm1);
+                                //endregion
+
+                                //region INPUT B
+                                // Load the input array of the position into a register:
+                                ymm0 = Avx<T>::From(inputB[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                sums[g] = Activation::ActivateMultiplyAddAdjacentAndAccumulate(sums[g], ymm0, ymm2);
+                                //endregion
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Avx<OT>::Store(Avx2<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[b + g] = sum[g] / Activation::Divisor + bias[row];
+                    }
+                }
+
+                // Forward propagate the remaining positions one at a time:
+                for (size_t b = Grouped; b < BatchSize; b++)
+                    output[b] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA[b], inputB[b], weight, bias, row);
+            }
+#endif
+
+#ifdef MANTARAY_AVX2
+            /// \brief The AVX2 implementation of ActivateFlattenAndForwardBatch().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize,
+                    size_t BatchSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX2
+            static void ActivateFlattenAndForwardBatch(
+                    const Target<InstructionSet::Avx2> target,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputA,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row,
+                    std::array<OT, BatchSize>& output)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Define the registers used in the inner loop:
+                Vec256I ymm0;
+                Vec256I ymm1;
+                Vec256I ymm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec256I) / sizeof(T);
+
+                // Define the number of positions propagated together (one for every 32-bit value of a register), and
+                // the number of positions in whole groups:
+                constexpr size_t Group   = sizeof(Vec256I) / sizeof(OT);
+                constexpr size_t Grouped = BatchSize / Group * Group;
+
+                // Forward propagate the whole groups of positions, loading every weight register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every position of the group:
+                    Vec256I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(32) std::array<OT, Group> sum;
+
+                    for (size_t b = 0; b < Grouped; b += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every position of the
+                        // group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the weight array of both inputs into registers:
+                            ymm1 = Avx<T>::From(weight, stride + j);
+                            ymm2 = Avx<T>::From(weight, InputSize + stride + j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                //region INPUT A
+                                // Load the input array of the position into a register:
+                                ymm0 = Avx<T>::From(inputA[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                ymm0 = Activation::ActivateMultiplyAndAddAdjacent(ymm0, ymm1);
+                                sums[g] = Avx2<OT>::Add(sums[g], ymm0);
+                                //endregion
+
+                                //region INPUT B
+                                // Load the input array of the position into a register:
+                                ymm0 = Avx<T>::From(inputB[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                ymm0 = Activation::ActivateMultiplyAndAddAdjacent(ymm0, ymm2);
+                                sums[g] = Avx2<OT>::Add(sums[g], ymm0);
+                                //endregion
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Avx<OT>::Store(Avx2<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[b + g] = sum[g] / Activation::Divisor + bias[row];
+                    }
+                }
+
+                // Forward propagate the remaining positions one at a time:
+                for (size_t b = Grouped; b < BatchSize; b++)
+                    output[b] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA[b], inputB[b], weight, bias, row);
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            /// \brief The SSE4.1 implementation of ActivateFlattenAndForwardBatch().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize,
+                    size_t BatchSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_SSE
+            static void ActivateFlattenAndForwardBatch(
+                    const Target<InstructionSet::Sse> target,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputA,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row,
+                    std::array<OT, BatchSize>& output)
+            {
+                // Define the stride with respect to the weight array:
+                const size_t stride = row * InputSize * 2;
+
+                // Define the registers used in the inner loop:
+                Vec128I xmm0;
+                Vec128I xmm1;
+                Vec128I xmm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec128I) / sizeof(T);
+
+                // Define the number of positions propagated together (one for every 32-bit value of a register), and
+                // the number of positions in whole groups:
+                constexpr size_t Group   = sizeof(Vec128I) / sizeof(OT);
+                constexpr size_t Grouped = BatchSize / Group * Group;
+
+                // Forward propagate the whole groups of positions, loading every weight register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every position of the group:
+                    Vec128I sums[Group];
+
+                    // Define the summed up outputs of the group, before they are scaled down and biased:
+                    alignas(16) std::array<OT, Group> sum;
+
+                    for (size_t b = 0; b < Grouped; b += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Sse<OT>::Zero();
+
+                        // Inner loop performing sum += activation(flatten(input)) * weight for every position of the
+                        // group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the weight array of both inputs into registers:
+                            xmm1 = Sse<T>::From(weight, stride + j);
+                            xmm2 = Sse<T>::From(weight, InputSize + stride + j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                //region INPUT A
+                                // Load the input array of the position into a register:
+                                xmm0 = Sse<T>::From(inputA[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                xmm0 = Activation::ActivateMultiplyAndAddAdjacent(xmm0, xmm1);
+                                sums[g] = Sse<OT>::Add(sums[g], xmm0);
+                                //endregion
+
+                                //region INPUT B
+                                // Load the input array of the position into a register:
+                                xmm0 = Sse<T>::From(inputB[b + g], j);
+
+                                // Activate the input register, multiply it by the weight register, and add the
+                                // result to the sum register of the position:
+                                xmm0 = Activation::ActivateMultiplyAndAddAdjacent(xmm0, xmm2);
+                                sums[g] = Sse<OT>::Add(sums[g], xmm0);
+                                //endregion
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        Sse<OT>::Store(Sse<OT>::Sum(sums), sum, 0);
+
+                        for (size_t g = 0; g < Group; g++)
+                            output[b + g] = sum[g] / Activation::Divisor + bias[row];
+                    }
+                }
+
+                // Forward propagate the remaining positions one at a time:
+                for (size_t b = Grouped; b < BatchSize; b++)
+                    output[b] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA[b], inputB[b], weight, bias, row);
+            }
+#endif
+
+            /// \brief The scalar implementation of ActivateFlattenAndForwardBatch().
+            template<typename Activation, typename T, typename OT, size_t InputSize, size_t OutputSize,
+                    size_t BatchSize>
+            [[clang::noinline]]
+            static void ActivateFlattenAndForwardBatch(
+                    const Target<InstructionSet::Scalar> target,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputA,
+                    const std::array<std::array<T, InputSize>, BatchSize>& inputB,
+                    const std::array<T, InputSize * 2 * OutputSize>& weight,
+                    const std::array<T, OutputSize>& bias, const uint32_t row,
+                    std::array<OT, BatchSize>& output)
+            {
+                // Forward propagate every position of the batch:
+                for (size_t b = 0; b < BatchSize; b++)
+                    output[b] = ActivateFlattenAndForwardRow<Activation, T, OT, InputSize, OutputSize>(
+                            target, inputA[b], inputB[b], weight, bias, row);
+            }
+
+            /// \brief Activate the input array and pack the activated values into 8-bit values.
+            /// \tparam Activation The activation function to use.
+            /// \tparam T The type of the input array.
+            /// \tparam InputSize The size of the input array.
+            /// \tparam OutputSize The size of the output array.
+            /// \param input The input array.
+            /// \param output The output array.
+            /// \param o The offset into the output array.
+            /// \details This function activates the input array and stores the activated values, in order, as 8-bit
+            ///          values in the output array starting at the given offset. The activation must clip the values
+            ///          to the range of int8_t, so that they can be used as the (unsigned) input of Forward().
+            template<typename Activation, typename T, size_t InputSize, size_t OutputSize>
+            static inline void ActivateAndPack(const std::array<T, InputSize>& input,
+                                               std::array<int8_t, OutputSize>& output, const uint32_t o)
+            {
+                Dispatch::Invoke([&](auto target) {
+                    ActivateAndPack<Activation, T, InputSize, OutputSize>(target, input, output, o);
+                });
+            }
+
+#ifdef MANTARAY_AVX512
+            /// \brief The AVX-512 implementation of ActivateAndPack().
+            template<typename Activation, typename T, size_t InputSize, size_t OutputSize>
+            MANTARAY_TARGET_AVX512
+            static inline void ActivateAndPack(Target<InstructionSet::Avx512>,
+                                               const std::array<T, InputSize>& input,
+                                               std::array<int8_t, OutputSize>& output, const uint32_t o)
+            {
+                static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                // Define the registers used in the loop:
+                Vec512I zmm0;
+                Vec512I zmm1;
+
+                // Define the step size for the loop (two input registers make up one output register):
+                constexpr size_t Step = sizeof(Vec512I) / sizeof(T);
+
+                for (size_t i = 0; i < InputSize; i += Step * 2) {
+                    // Load the input array into registers and activate them:
+                    zmm0 = Activation::Activate(Avx512<T>::From(input, i       ));
+                    zmm1 = Activation::Activate(Avx512<T>::From(input, i + Step));
+
+                    // Pack the activated registers and store the result into the output array:
+                    Avx512<int8_t>::Store(Avx512<T>::Pack(zmm0, zmm1), output, o + i);
+                }
+            }
+#endif
+
+#ifdef MANTARAY_AVX2
+            /// \brief The AVX2 implementation of ActivateAndPack().
+            template<typename Activation, typename T, size_t InputSize, size_t OutputSize>
+            MANTARAY_TARGET_AVX2
+            static inline void ActivateAndPack(Target<InstructionSet::Avx2>,
+                                               const std::array<T, InputSize>& input,
+                                               std::array<int8_t, OutputSize>& output, const uint32_t o)
+            {
+                static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                // Define the registers used in the loop:
+                Vec256I ymm0;
+                Vec256I ymm1;
+
+                // Define the step size for the loop (two input registers make up one output register):
+                constexpr size_t Step = sizeof(Vec256I) / sizeof(T);
+
+                for (size_t i = 0; i < InputSize; i += Step * 2) {
+                    // Load the input array into registers and activate them:
+                    ymm0 = Activation::Activate(Avx<T>::From(input, i       ));
+                    ymm1 = Activation::Activate(Avx<T>::From(input, i + Step));
+
+                    // Pack the activated registers and store the result into the output array:
+                    Avx<int8_t>::Store(Avx2<T>::Pack(ymm0, ymm1), output, o + i);
+                }
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            /// \brief The SSE4.1 implementation of ActivateAndPack().
+            template<typename Activation, typename T, size_t InputSize, size_t OutputSize>
+            MANTARAY_TARGET_SSE
+            static inline void ActivateAndPack(Target<InstructionSet::Sse>,
+                                               const std::array<T, InputSize>& input,
+                                               std::array<int8_t, OutputSize>& output, const uint32_t o)
+            {
+                static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                // Define the registers used in the loop:
+                Vec128I xmm0;
+                Vec128I xmm1;
+
+                // Define the step size for the loop (two input registers make up one output register):
+                constexpr size_t Step = sizeof(Vec128I) / sizeof(T);
+
+                for (size_t i = 0; i < InputSize; i += Step * 2) {
+                    // Load the input array into registers and activate them:
+                    xmm0 = Activation::Activate(Sse<T>::From(input, i       ));
+                    xmm1 = Activation::Activate(Sse<T>::From(input, i + Step));
+
+                    // Pack the activated registers and store the result into the output array:
+                    Sse<int8_t>::Store(Sse<T>::Pack(xmm0, xmm1), output, o + i);
+                }
+            }
+#endif
+
+            /// \brief The scalar implementation of ActivateAndPack().
+            template<typename Activation, typename T, size_t InputSize, size_t OutputSize>
+            static inline void ActivateAndPack(Target<InstructionSet::Scalar>,
+                                               const std::array<T, InputSize>& input,
+                                               std::array<int8_t, OutputSize>& output, const uint32_t o)
+            {
+                static_assert(std::is_same_v<T, int16_t>, "Unsupported type provided.");
+
+                for (size_t i = 0; i < InputSize; i++)
+                    output[o + i] = static_cast<int8_t>(Activation::Activate(input[i]));
+            }
+
+            /// \brief Find the non-zero 4-byte chunks of an 8-bit input array.
+            /// \tparam InputSize The size of the input array.
+            /// \param input The input array.
+            /// \param indices The array to store the indices of the non-zero chunks in, in ascending order.
+            /// \return The number of non-zero chunks.
+            /// \details Every register of the input array is compared with zero as 32-bit values, and the resulting
+            ///          mask is expanded into chunk indices eight bits at a time using a lookup table.
+            template<size_t InputSize>
+            static inline size_t NonZeroChunks(const std::array<int8_t, InputSize>& input,
+                                               std::array<uint16_t, InputSize / 4>& indices)
+            {
+                return Dispatch::Invoke([&](auto target) {
+                    return NonZeroChunks<InputSize>(target, input, indices);
+                });
+            }
+
+#ifdef MANTARAY_AVX512
+            /// \brief The AVX-512 implementation of NonZeroChunks().
+            template<size_t InputSize>
+            MANTARAY_TARGET_AVX512
+            static inline size_t NonZeroChunks(Target<InstructionSet::Avx512>,
+                                               const std::array<int8_t, InputSize>& input,
+                                               std::array<uint16_t, InputSize / 4>& indices)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                size_t count = 0;
+
+                // Define the register used in the loop:
+                Vec512I zmm0;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec512I) / sizeof(int8_t);
+
+                for (size_t i = 0; i < InputSize; i += Step) {
+                    // Load the input array into a register and find its non-zero chunks:
+                    zmm0 = Avx512<int8_t>::From(input, i);
+                    const uint32_t mask = Avx512<int32_t>::NonZeroMask(zmm0);
+
+                    // Expand the mask into chunk indices, eight chunks at a time:
+                    for (uint32_t j = 0; j < Step / ChunkSize; j += 8) {
+                        const auto byte = static_cast<uint8_t>(mask >> j);
+                        const std::array<uint16_t, 8>& entry = MaskIndices[byte];
+
+                        for (uint8_t k = 0; k < 8; k++) indices[count + k] = i / ChunkSize + j + entry[k];
+                        count += std::popcount(byte);
+                    }
+                }
+
+                return count;
+            }
+#endif
+
+#ifdef MANTARAY_AVX2
+            /// \brief The AVX2 implementation of NonZeroChunks().
+            template<size_t InputSize>
+            MANTARAY_TARGET_AVX2
+            static inline size_t NonZeroChunks(Target<InstructionSet::Avx2>,
+                                               const std::array<int8_t, InputSize>& input,
+                                               std::array<uint16_t, InputSize / 4>& indices)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                size_t count = 0;
+
+                // Define the register used in the loop:
+                Vec256I ymm0;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec256I) / sizeof(int8_t);
+
+                for (size_t i = 0; i < InputSize; i += Step) {
+                    // Load the input array into a register and find its non-zero chunks:
+                    ymm0 = Avx<int8_t>::From(input, i);
+                    const auto byte = static_cast<uint8_t>(Avx2<int32_t>::NonZeroMask(ymm0));
+
+                    // Expand the mask into chunk indices:
+                    const std::array<uint16_t, 8>& entry = MaskIndices[byte];
+
+                    for (uint8_t k = 0; k < 8; k++) indices[count + k] = i / ChunkSize + entry[k];
+                    count += std::popcount(byte);
+                }
+
+                return count;
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            /// \brief The SSE4.1 implementation of NonZeroChunks().
+            template<size_t InputSize>
+            MANTARAY_TARGET_SSE
+            static inline size_t NonZeroChunks(Target<InstructionSet::Sse>,
+                                               const std::array<int8_t, InputSize>& input,
+                                               std::array<uint16_t, InputSize / 4>& indices)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                size_t count = 0;
+
+                // Define the registers used in the loop:
+                Vec128I xmm0;
+                Vec128I xmm1;
+
+                // Define the step size for the loop (two registers make up eight chunks):
+                constexpr size_t Step = sizeof(Vec128I) / sizeof(int8_t);
+
+                for (size_t i = 0; i < InputSize; i += Step * 2) {
+                    // Load the input array into registers and find their non-zero chunks:
+                    xmm0 = Sse<int8_t>::From(input, i       );
+                    xmm1 = Sse<int8_t>::From(input, i + Step);
+                    const auto byte = static_cast<uint8_t>(Sse<int32_t>::NonZeroMask(xmm0) |
+                                                           Sse<int32_t>::NonZeroMask(xmm1) << 4);
+
+                    // Expand the mask into chunk indices:
+                    const std::array<uint16_t, 8>& entry = MaskIndices[byte];
+
+                    for (uint8_t k = 0; k < 8; k++) indices[count + k] = i / ChunkSize + entry[k];
+                    count += std::popcount(byte);
+                }
+
+                return count;
+            }
+#endif
+
+            /// \brief The scalar implementation of NonZeroChunks().
+            template<size_t InputSize>
+            static inline size_t NonZeroChunks(Target<InstructionSet::Scalar>,
+                                               const std::array<int8_t, InputSize>& input,
+                                               std::array<uint16_t, InputSize / 4>& indices)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                size_t count = 0;
+
+                for (size_t i = 0; i < InputSize; i += ChunkSize) {
+                    int32_t chunk;
+                    std::memcpy(&chunk, &input[i], ChunkSize);
+
+                    if (chunk != 0) indices[count++] = i / ChunkSize;
+                }
+
+                return count;
+            }
+
+            /// \brief Forward propagate a sparse 8-bit input array through an 8-bit weight array.
+            /// \tparam InputSize The size of the input array.
+            /// \tparam OutputSize The size of the output array.
+            /// \param input The input array, holding unsigned values in the range of int8_t.
+            /// \param weight The weight array, with the weights of every 4-byte input chunk stored contiguously (for
+            ///               every output, the 4 weights of the chunk).
+            /// \param bias The bias array.
+            /// \param output The output array.
+            /// \details This function performs output = input * weight + bias like Forward(), but only for the
+            ///          non-zero 4-byte chunks of the input. Every non-zero chunk is broadcast to a register and
+            ///          multiplied with the weights of that chunk for all outputs at once, so the work done is
+            ///          proportional to the number of non-zero chunks rather than to the size of the input. This pays
+            ///          off for the activated accumulator, where clipping leaves most of the values at zero.
+            template<size_t InputSize, size_t OutputSize>
+            static inline void SparseForward(const std::array<int8_t, InputSize>& input,
+                                      const std::array<int8_t, InputSize * OutputSize>& weight,
+                                      const std::array<int32_t, OutputSize>& bias,
+                                      std::array<int32_t, OutputSize>& output)
+            {
+                Dispatch::Invoke([&](auto target) {
+                    SparseForward<InputSize, OutputSize>(target, input, weight, bias, output);
+                });
+            }
+
+#ifdef MANTARAY_AVX512_VNNI
+            /// \brief The AVX-512 VNNI implementation of SparseForward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX512_VNNI
+            static void SparseForward(const Target<InstructionSet::Avx512Vnni> target,
+                                      const std::array<int8_t, InputSize>& input,
+                                      const std::array<int8_t, InputSize * OutputSize>& weight,
+                                      const std::array<int32_t, OutputSize>& bias,
+                                      std::array<int32_t, OutputSize>& output)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                // Find the non-zero chunks of the input:
+                std::array<uint16_t, InputSize / ChunkSize> indices;
+                const size_t count = NonZeroChunks<InputSize>(target, input, indices);
+
+                // Define the number of registers needed to hold the output:
+                constexpr size_t Step          = sizeof(Vec512I) / sizeof(int32_t);
+                constexpr size_t RegisterCount = OutputSize / Step;
+
+                static_assert(OutputSize % Step == 0, "The output size must fill whole registers.");
+
+                // The accumulating multiply-add has a longer latency than the addition it replaces, so consecutive
+                // chunks are accumulated into separate sets of sums, keeping enough independent additions in flight:
+                constexpr size_t SetCount = RegisterCount >= 8 ? 1 : 8 / RegisterCount;
+
+                // Define the registers for sum accumulation, starting from the bias in the first set:
+                Vec512I sums[SetCount][RegisterCount];
+                for (size_t k = 0; k < RegisterCount; k++) sums[0][k] = Avx512<int32_t>::From(bias, k * Step);
+                for (size_t j = 1; j < SetCount; j++)
+                    for (size_t k = 0; k < RegisterCount; k++) sums[j][k] = Avx512<int32_t>::Zero();
+
+                // Define the registers used in the inner loop:
+                Vec512I zmm0;
+                Vec512I zmm1;
+
+                size_t i = 0;
+
+                // Accumulate every group of consecutive chunks, one chunk into each set of sums:
+                for (; i + SetCount <= count; i += SetCount) {
+                    for (size_t j = 0; j < SetCount; j++) {
+                        const size_t chunk  = indices[i + j];
+                        const size_t stride = chunk * OutputSize * ChunkSize;
+
+                        // Broadcast the chunk of the input array into a register:
+                        int32_t value;
+                        std::memcpy(&value, &input[chunk * ChunkSize], ChunkSize);
+                        zmm0 = Avx512<int32_t>::From(value);
+
+                        // Multiply the chunk with its weights for every output, and add the result to the sums:
+                        for (size_t k = 0; k < RegisterCount; k++) {
+                            zmm1 = Avx512<int8_t>::From(weight, stride + k * sizeof(Vec512I));
+                            sums[j][k] = Avx512Vnni<int8_t>::MultiplyAddAdjacentAndAccumulate(sums[j][k], zmm0, zmm1);
+                        }
+                    }
+                }
+
+                // Accumulate the remaining chunks into the first set of sums:
+                for (; i < count; i++) {
+                    const size_t chunk  = indices[i];
+                    const size_t stride = chunk * OutputSize * ChunkSize;
+
+                    int32_t value;
+                    std::memcpy(&value, &input[chunk * ChunkSize], ChunkSize);
+                    zmm0 = Avx512<int32_t>::From(value);
+
+                    for (size_t k = 0; k < RegisterCount; k++) {
+                        zmm1 = Avx512<int8_t>::From(weight, stride + k * sizeof(Vec512I));
+                        sums[0][k] = Avx512Vnni<int8_t>::MultiplyAddAdjacentAndAccumulate(sums[0][k], zmm0, zmm1);
+                    }
+                }
+
+                // Add up the sets of sums:
+                for (size_t j = 1; j < SetCount; j++)
+                    for (size_t k = 0; k < RegisterCount; k++)
+                        sums[0][k] = Avx512<int32_t>::Add(sums[0][k], sums[j][k]);
+
+                // Store the sums into the output array:
+                for (size_t k = 0; k < RegisterCount; k++) Avx512<int32_t>::Store(sums[0][k], output, k * Step);
+            }
+#endif
+
+#ifdef MANTARAY_AVX512
+            /// \brief The AVX-512 implementation of SparseForward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX512
+            static void SparseForward(const Target<InstructionSet::Avx512> target,
+                                      const std::array<int8_t, InputSize>& input,
+                                      const std::array<int8_t, InputSize * OutputSize>& weight,
+                                      const std::array<int32_t, OutputSize>& bias,
+                                      std::array<int32_t, OutputSize>& output)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                // Find the non-zero chunks of the input:
+                std::array<uint16_t, InputSize / ChunkSize> indices;
+                const size_t count = NonZeroChunks<InputSize>(target, input, indices);
+
+                // Define the number of registers needed to hold the output:
+                constexpr size_t Step          = sizeof(Vec512I) / sizeof(int32_t);
+                constexpr size_t RegisterCount = OutputSize / Step;
+
+                static_assert(OutputSize % Step == 0, "The output size must fill whole registers.");
+
+                // Define the register used to widen the 16-bit sums into 32-bit sums:
+                const Vec512I one = Avx512<int16_t>::From(1);
+
+                // Define the registers for sum accumulation, starting from the bias:
+                Vec512I sums[RegisterCount];
+                for (size_t k = 0; k < RegisterCount; k++) sums[k] = Avx512<int32_t>::From(bias, k * Step);
+
+                // Define the registers used in the inner loop:
+                Vec512I zmm0;
+                Vec512I zmm1;
+
+                for (size_t i = 0; i < count; i++) {
+                    const size_t chunk  = indices[i];
+                    const size_t stride = chunk * OutputSize * ChunkSize;
+
+                    // Broadcast the chunk of the input array into a register:
+                    int32_t value;
+                    std::memcpy(&value, &input[chunk * ChunkSize], ChunkSize);
+                    zmm0 = Avx512<int32_t>::From(value);
+
+                    // Multiply the chunk with its weights for every output, and add the result to the sums:
+                    for (size_t k = 0; k < RegisterCount; k++) {
+                        zmm1 = Avx512<int8_t >::From(weight, stride + k * sizeof(Vec512I));
+                        zmm1 = Avx512<int8_t >::MultiplyAndAddAdjacent(zmm0, zmm1);
+                        zmm1 = Avx512<int16_t>::MultiplyAndAddAdjacent(zmm1, one );
+                        sums[k] = Avx512<int32_t>::Add(sums[k], zmm1);
+                    }
+                }
+
+                // Store the sums into the output array:
+                for (size_t k = 0; k < RegisterCount; k++) Avx512<int32_t>::Store(sums[k], output, k * Step);
+            }
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+            /// \brief The AVX-VNNI implementation of SparseForward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX_VNNI
+            static void SparseForward(const Target<InstructionSet::AvxVnni> target,
+                                      const std::array<int8_t, InputSize>& input,
+                                      const std::array<int8_t, InputSize * OutputSize>& weight,
+                                      const std::array<int32_t, OutputSize>& bias,
+                                      std::array<int32_t, OutputSize>& output)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                // Find the non-zero chunks of the input:
+                std::array<uint16_t, InputSize / ChunkSize> indices;
+                const size_t count = NonZeroChunks<InputSize>(target, input, indices);
+
+                // Define the number of registers needed to hold the output:
+                constexpr size_t Step          = sizeof(Vec256I) / sizeof(int32_t);
+                constexpr size_t RegisterCount = OutputSize / Step;
+
+                static_assert(OutputSize % Step == 0, "The output size must fill whole registers.");
+
+                // The accumulating multiply-add has a longer latency than the addition it replaces, so consecutive
+                // chunks are accumulated into separate sets of sums, keeping enough independent additions in flight:
+                constexpr size_t SetCount = RegisterCount >= 8 ? 1 : 8 / RegisterCount;
+
+                // Define the registers for sum accumulation, starting from the bias in the first set:
+                Vec256I sums[SetCount][RegisterCount];
+                for (size_t k = 0; k < RegisterCount; k++) sums[0][k] = Avx<int32_t>::From(bias, k * Step);
+                for (size_t j = 1; j < SetCount; j++)
+                    for (size_t k = 0; k < RegisterCount; k++) sums[j][k] = Avx<int32_t>::Zero();
+
+                // Define the registers used in the inner loop:
+                Vec256I ymm0;
+                Vec256I ymm1;
+
+                size_t i = 0;
+
+                // Accumulate every group of consecutive chunks, one chunk into each set of sums:
+                for (; i + SetCount <= count; i += SetCount) {
+                    for (size_t j = 0; j < SetCount; j++) {
+                        const size_t chunk  = indices[i + j];
+                        const size_t stride = chunk * OutputSize * ChunkSize;
+
+                        // Broadcast the chunk of the input array into a register:
+                        int32_t value;
+                        std::memcpy(&value, &input[chunk * ChunkSize], ChunkSize);
+                        ymm0 = Avx<int32_t>::From(value);
+
+                        // Multiply the chunk with its weights for every output, and add the result to the sums:
+                        for (size_t k = 0; k < RegisterCount; k++) {
+                            ymm1 = Avx<int8_t>::From(weight, stride + k * sizeof(Vec256I));
+                            sums[j][k] = AvxVnni<int8_t>::MultiplyAddAdjacentAndAccumulate(sums[j][k], ymm0, ymm1);
+                        }
+                    }
+                }
+
+                // Accumulate the remaining chunks into the first set of sums:
+                for (; i < count; i++) {
+                    const size_t chunk  = indices[i];
+                    const size_t stride = chunk * OutputSize * ChunkSize;
+
+                    int32_t value;
+                    std::memcpy(&value, &input[chunk * ChunkSize], ChunkSize);
+                    ymm0 = Avx<int32_t>::From(value);
+
+                    for (size_t k = 0; k < RegisterCount; k++) {
+                        ymm1 = Avx<int8_t>::From(weight, stride + k * sizeof(Vec256I));
+                        sums[0][k] = AvxVnni<int8_t>::MultiplyAddAdjacentAndAccumulate(sums[0][k], ymm0, ymm1);
+                    }
+                }
+
+                // Add up the sets of sums:
+                for (size_t j = 1; j < SetCount; j++)
+                    for (size_t k = 0; k < RegisterCount; k++)
+                        sums[0][k] = Avx2<int32_t>::Add(sums[0][k], sums[j][k]);
+
+                // Store the sums into the output array:
+                for (size_t k = 0; k < RegisterCount; k++) Avx<int32_t>::Store(sums[0][k], output, k * Step);
+            }
+#endif
+
+#ifdef MANTARAY_AVX2
+            /// \brief The AVX2 implementation of SparseForward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX2
+            static void SparseForward(const Target<InstructionSet::Avx2> target,
+                                      const std::array<int8_t, InputSize>& input,
+                                      const std::array<int8_t, InputSize * OutputSize>& weight,
+                                      const std::array<int32_t, OutputSize>& bias,
+                                      std::array<int32_t, OutputSize>& output)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                // Find the non-zero chunks of the input:
+                std::array<uint16_t, InputSize / ChunkSize> indices;
+                const size_t count = NonZeroChunks<InputSize>(target, input, indices);
+
+                // Define the number of registers needed to hold the output:
+                constexpr size_t Step          = sizeof(Vec256I) / sizeof(int32_t);
+                constexpr size_t RegisterCount = OutputSize / Step;
+
+                static_assert(OutputSize % Step == 0, "The output size must fill whole registers.");
+
+                // Define the register used to widen the 16-bit sums into 32-bit sums:
+                const Vec256I one = Avx<int16_t>::From(1);
+
+                // Define the registers for sum accumulation, starting from the bias:
+                Vec256I sums[RegisterCount];
+                for (size_t k = 0; k < RegisterCount; k++) sums[k] = Avx<int32_t>::From(bias, k * Step);
+
+                // Define the registers used in the inner loop:
+                Vec256I ymm0;
+                Vec256I ymm1;
+
+                for (size_t i = 0; i < count; i++) {
+                    const size_t chunk  = indices[i];
+                    const size_t stride = chunk * OutputSize * ChunkSize;
+
+                    // Broadcast the chunk of the input array into a register:
+                    int32_t value;
+                    std::memcpy(&value, &input[chunk * ChunkSize], ChunkSize);
+                    ymm0 = Avx<int32_t>::From(value);
+
+                    // Multiply the chunk with its weights for every output, and add the result to the sums:
+                    for (size_t k = 0; k < RegisterCount; k++) {
+                        ymm1 = Avx<int8_t>::From(weight, stride + k * sizeof(Vec256I));
+                        ymm1 = Avx2<int8_t >::MultiplyAndAddAdjacent(ymm0, ymm1);
+                        ymm1 = Avx2<int16_t>::MultiplyAndAddAdjacent(ymm1, one );
+                        sums[k] = Avx2<int32_t>::Add(sums[k], ymm1);
+                    }
+                }
+
+                // Store the sums into the output array:
+                for (size_t k = 0; k < RegisterCount; k++) Avx<int32_t>::Store(sums[k], output, k * Step);
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            /// \brief The SSE4.1 implementation of SparseForward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_SSE
+            static void SparseForward(const Target<InstructionSet::Sse> target,
+                                      const std::array<int8_t, InputSize>& input,
+                                      const std::array<int8_t, InputSize * OutputSize>& weight,
+                                      const std::array<int32_t, OutputSize>& bias,
+                                      std::array<int32_t, OutputSize>& output)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                // Find the non-zero chunks of the input:
+                std::array<uint16_t, InputSize / ChunkSize> indices;
+                const size_t count = NonZeroChunks<InputSize>(target, input, indices);
+
+                // Define the number of registers needed to hold the output:
+                constexpr size_t Step          = sizeof(Vec128I) / sizeof(int32_t);
+                constexpr size_t RegisterCount = OutputSize / Step;
+
+                static_assert(OutputSize % Step == 0, "The output size must fill whole registers.");
+
+                // Define the register used to widen the 16-bit sums into 32-bit sums:
+                const Vec128I one = Sse<int16_t>::From(1);
+
+                // Define the registers for sum accumulation, starting from the bias:
+                Vec128I sums[RegisterCount];
+                for (size_t k = 0; k < RegisterCount; k++) sums[k] = Sse<int32_t>::From(bias, k * Step);
+
+                // Define the registers used in the inner loop:
+                Vec128I xmm0;
+                Vec128I xmm1;
+
+                for (size_t i = 0; i < count; i++) {
+                    const size_t chunk  = indices[i];
+                    const size_t stride = chunk * OutputSize * ChunkSize;
+
+                    // Broadcast the chunk of the input array into a register:
+                    int32_t value;
+                    std::memcpy(&value, &input[chunk * ChunkSize], ChunkSize);
+                    xmm0 = Sse<int32_t>::From(value);
+
+                    // Multiply the chunk with its weights for every output, and add the result to the sums:
+                    for (size_t k = 0; k < RegisterCount; k++) {
+                        xmm1 = Sse<int8_t>::From(weight, stride + k * sizeof(Vec128I));
+                        xmm1 = Sse<int8_t >::MultiplyAndAddAdjacent(xmm0, xmm1);
+                        xmm1 = Sse<int16_t>::MultiplyAndAddAdjacent(xmm1, one );
+                        sums[k] = Sse<int32_t>::Add(sums[k], xmm1);
+                    }
+                }
+
+                // Store the sums into the output array:
+                for (size_t k = 0; k < RegisterCount; k++) Sse<int32_t>::Store(sums[k], output, k * Step);
+            }
+#endif
+
+            /// \brief The scalar implementation of SparseForward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            static void SparseForward(const Target<InstructionSet::Scalar> target,
+                                      const std::array<int8_t, InputSize>& input,
+                                      const std::array<int8_t, InputSize * OutputSize>& weight,
+                                      const std::array<int32_t, OutputSize>& bias,
+                                      std::array<int32_t, OutputSize>& output)
+            {
+                // Define the number of inputs in a chunk:
+                constexpr size_t ChunkSize = sizeof(int32_t) / sizeof(int8_t);
+
+                // Find the non-zero chunks of the input:
+                std::array<uint16_t, InputSize / ChunkSize> indices;
+                const size_t count = NonZeroChunks<InputSize>(target, input, indices);
+
+                std::copy(std::begin(bias), std::end(bias), std::begin(output));
+
+                for (size_t i = 0; i < count; i++) {
+                    const size_t chunk  = indices[i];
+                    const size_t stride = chunk * OutputSize * ChunkSize;
+
+                    // Add the (unsigned) inputs of the chunk multiplied by their weights to every output:
+                    for (size_t o = 0; o < OutputSize; o++)
+                        for (size_t j = 0; j < ChunkSize; j++)
+                            output[o] += static_cast<uint8_t>(input[chunk * ChunkSize + j]) *
+                                         weight[stride + o * ChunkSize + j];
+                }
+            }
+
+            /// \brief Forward propagate an 8-bit input array through an 8-bit weight array.
+            /// \tparam InputSize The size of the input array.
+            /// \tparam OutputSize The size of the output array.
+            /// \param input The input array, holding unsigned values in the range of int8_t.
+            /// \param weight The weight array, with the weights of every output stored contiguously.
+            /// \param bias The bias array.
+            /// \param output The output array.
+            /// \details This function performs output = input * weight + bias. The 8-bit products are multiplied and
+            ///          added in pairs into 16-bit values, which are in turn added in pairs into 32-bit values. The
+            ///          pairs of 16-bit values can't saturate as long as the inputs and weights are within the range of
+            ///          int8_t (with the inputs being non-negative). With VNNI, the products are added in fours
+            ///          directly into the 32-bit values with a single instruction.
+            template<size_t InputSize, size_t OutputSize>
+            static inline void Forward(const std::array<int8_t, InputSize>& input,
+                                const std::array<int8_t, InputSize * OutputSize>& weight,
+                                const std::array<int32_t, OutputSize>& bias,
+                                std::array<int32_t, OutputSize>& output)
+            {
+                Dispatch::Invoke([&](auto target) {
+                    Forward<InputSize, OutputSize>(target, input, weight, bias, output);
+                });
+            }
+
+#ifdef MANTARAY_AVX512_VNNI
+            /// \brief The AVX-512 VNNI implementation of Forward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX512_VNNI
+            static void Forward(Target<InstructionSet::Avx512Vnni>,
+                                const std::array<int8_t, InputSize>& input,
+                                const std::array<int8_t, InputSize * OutputSize>& weight,
+                                const std::array<int32_t, OutputSize>& bias,
+                                std::array<int32_t, OutputSize>& output)
+            {
+                // Define the registers used in the inner loop:
+                Vec512I zmm0;
+                Vec512I zmm1;
+                Vec512I zmm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec512I) / sizeof(int8_t);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec512I) / sizeof(int32_t);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, loading every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec512I sums[Group];
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx512<int32_t>::Zero();
+
+                        // Inner loop performing sum += input * weight for every output of the group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the input array into a register:
+                            zmm1 = Avx512<int8_t>::From(input, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                zmm2 = Avx512<int8_t>::From(weight, (i + g) * InputSize + j);
+
+                                // Multiply and add every four 8-bit values into 32-bit sums, and add the result to
+                                // the sum register of the output:
+                                sums[g] = Avx512Vnni<int8_t>::MultiplyAddAdjacentAndAccumulate(sums[g], zmm1, zmm2);
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        zmm0 = Avx512<int32_t>::Sum(sums);
+                        zmm0 = Avx512<int32_t>::Add(zmm0, Avx512<int32_t>::From(bias, i));
+                        Avx512<int32_t>::Store(zmm0, output, i);
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++) {
+                    const size_t stride = i * InputSize;
+
+                    // Define the register for sum accumulation:
+                    zmm0 = Avx512<int32_t>::Zero();
+
+                    // Inner loop performing sum += input * weight:
+                    for (size_t j = 0; j < InputSize; j += Step) {
+                        // Load the input array and weight array into registers:
+                        zmm1 = Avx512<int8_t>::From(input ,          j);
+                        zmm2 = Avx512<int8_t>::From(weight, stride + j);
+
+                        // Multiply and add every four 8-bit values into 32-bit sums, and add the result to the sum
+                        // register:
+                        zmm0 = Avx512Vnni<int8_t>::MultiplyAddAdjacentAndAccumulate(zmm0, zmm1, zmm2);
+                    }
+
+                    // Sum up the sum accumulation register and store the result with respect to the bias:
+                    output[i] = Avx512<int32_t>::Sum(zmm0) + bias[i];
+                }
+            }
+#endif
+
+#ifdef MANTARAY_AVX512
+            /// \brief The AVX-512 implementation of Forward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX512
+            static void Forward(Target<InstructionSet::Avx512>,
+                                const std::array<int8_t, InputSize>& input,
+                                const std::array<int8_t, InputSize * OutputSize>& weight,
+                                const std::array<int32_t, OutputSize>& bias,
+                                std::array<int32_t, OutputSize>& output)
+            {
+                // Define the register used to widen the 16-bit sums into 32-bit sums:
+                const Vec512I one = Avx512<int16_t>::From(1);
+
+                // Define the registers used in the inner loop:
+                Vec512I zmm0;
+                Vec512I zmm1;
+                Vec512I zmm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec512I) / sizeof(int8_t);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec512I) / sizeof(int32_t);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, loading every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec512I sums[Group];
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx512<int32_t>::Zero();
+
+                        // Inner loop performing sum += input * weight for every output of the group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the input array into a register:
+                            zmm1 = Avx512<int8_t>::From(input, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                zmm2 = Avx512<int8_t>::From(weight, (i + g) * InputSize + j);
+
+                                // Multiply and add the 8-bit values into 16-bit sums, widen them into 32-bit sums, and
+                                // add the result to the sum register of the output:
+                                zmm2 = Avx512<int8_t >::MultiplyAndAddAdjacent(zmm1, zmm2);
+                                zmm2 = Avx512<int16_t>::MultiplyAndAddAdjacent(zmm2, one );
+                                sums[g] = Avx512<int32_t>::Add(sums[g], zmm2);
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        zmm0 = Avx512<int32_t>::Sum(sums);
+                        zmm0 = Avx512<int32_t>::Add(zmm0, Avx512<int32_t>::From(bias, i));
+                        Avx512<int32_t>::Store(zmm0, output, i);
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++) {
+                    const size_t stride = i * InputSize;
+
+                    // Define the register for sum accumulation:
+                    zmm0 = Avx512<int32_t>::Zero();
+
+                    // Inner loop performing sum += input * weight:
+                    for (size_t j = 0; j < InputSize; j += Step) {
+                        // Load the input array and weight array into registers:
+                        zmm1 = Avx512<int8_t>::From(input ,          j);
+                        zmm2 = Avx512<int8_t>::From(weight, stride + j);
+
+                        // Multiply and add the 8-bit values into 16-bit sums, widen them into 32-bit sums, and add the
+                        // result to the sum register:
+                        zmm1 = Avx512<int8_t >::MultiplyAndAddAdjacent(zmm1, zmm2);
+                        zmm1 = Avx512<int16_t>::MultiplyAndAddAdjacent(zmm1, one );
+                        zmm0 = Avx512<int32_t>::Add(zmm0, zmm1);
+                    }
+
+                    // Sum up the sum accumulation register and store the result with respect to the bias:
+                    output[i] = Avx512<int32_t>::Sum(zmm0) + bias[i];
+                }
+            }
+#endif
+
+#ifdef MANTARAY_AVX_VNNI
+            /// \brief The AVX-VNNI implementation of Forward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX_VNNI
+            static void Forward(Target<InstructionSet::AvxVnni>,
+                                const std::array<int8_t, InputSize>& input,
+                                const std::array<int8_t, InputSize * OutputSize>& weight,
+                                const std::array<int32_t, OutputSize>& bias,
+                                std::array<int32_t, OutputSize>& output)
+            {
+                // Define the registers used in the inner loop:
+                Vec256I ymm0;
+                Vec256I ymm1;
+                Vec256I ymm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec256I) / sizeof(int8_t);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec256I) / sizeof(int32_t);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, loading every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec256I sums[Group];
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx<int32_t>::Zero();
+
+                        // Inner loop performing sum += input * weight for every output of the group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the input array into a register:
+                            ymm1 = Avx<int8_t>::From(input, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                ymm2 = Avx<int8_t>::From(weight, (i + g) * InputSize + j);
+
+                                // Multiply and add every four 8-bit values into 32-bit sums, and add the result to
+                                // the sum register of the output:
+                                sums[g] = AvxVnni<int8_t>::MultiplyAddAdjacentAndAccumulate(sums[g], ymm1, ymm2);
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        ymm0 = Avx2<int32_t>::Sum(sums);
+                        ymm0 = Avx2<int32_t>::Add(ymm0, Avx<int32_t>::From(bias, i));
+                        Avx<int32_t>::Store(ymm0, output, i);
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++) {
+                    const size_t stride = i * InputSize;
+
+                    // Define the register for sum accumulation:
+                    ymm0 = Avx<int32_t>::Zero();
+
+                    // Inner loop performing sum += input * weight:
+                    for (size_t j = 0; j < InputSize; j += Step) {
+                        // Load the input array and weight array into registers:
+                        ymm1 = Avx<int8_t>::From(input ,          j);
+                        ymm2 = Avx<int8_t>::From(weight, stride + j);
+
+                        // Multiply and add every four 8-bit values into 32-bit sums, and add the result to the sum
+                        // register:
+                        ymm0 = AvxVnni<int8_t>::MultiplyAddAdjacentAndAccumulate(ymm0, ymm1, ymm2);
+                    }
+
+                    // Sum up the sum accumulation register and store the result with respect to the bias:
+                    output[i] = Avx2<int32_t>::Sum(ymm0) + bias[i];
+                }
+            }
+#endif
+
+#ifdef MANTARAY_AVX2
+            /// \brief The AVX2 implementation of Forward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_AVX2
+            static void Forward(Target<InstructionSet::Avx2>,
+                                const std::array<int8_t, InputSize>& input,
+                                const std::array<int8_t, InputSize * OutputSize>& weight,
+                                const std::array<int32_t, OutputSize>& bias,
+                                std::array<int32_t, OutputSize>& output)
+            {
+                // Define the register used to widen the 16-bit sums into 32-bit sums:
+                const Vec256I one = Avx<int16_t>::From(1);
+
+                // Define the registers used in the inner loop:
+                Vec256I ymm0;
+                Vec256I ymm1;
+                Vec256I ymm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec256I) / sizeof(int8_t);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec256I) / sizeof(int32_t);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, loading every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec256I sums[Group];
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Avx<int32_t>::Zero();
+
+                        // Inner loop performing sum += input * weight for every output of the group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the input array into a register:
+                            ymm1 = Avx<int8_t>::From(input, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                ymm2 = Avx<int8_t>::From(weight, (i + g) * InputSize + j);
+
+                                // Multiply and add the 8-bit values into 16-bit sums, widen them into 32-bit sums, and
+                                // add the result to the sum register of the output:
+                                ymm2 = Avx2<int8_t >::MultiplyAndAddAdjacent(ymm1, ymm2);
+                                ymm2 = Avx2<int16_t>::MultiplyAndAddAdjacent(ymm2, one );
+                                sums[g] = Avx2<int32_t>::Add(sums[g], ymm2);
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        ymm0 = Avx2<int32_t>::Sum(sums);
+                        ymm0 = Avx2<int32_t>::Add(ymm0, Avx<int32_t>::From(bias, i));
+                        Avx<int32_t>::Store(ymm0, output, i);
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++) {
+                    const size_t stride = i * InputSize;
+
+                    // Define the register for sum accumulation:
+                    ymm0 = Avx<int32_t>::Zero();
+
+                    // Inner loop performing sum += input * weight:
+                    for (size_t j = 0; j < InputSize; j += Step) {
+                        // Load the input array and weight array into registers:
+                        ymm1 = Avx<int8_t>::From(input ,          j);
+                        ymm2 = Avx<int8_t>::From(weight, stride + j);
+
+                        // Multiply and add the 8-bit values into 16-bit sums, widen them into 32-bit sums, and add the
+                        // result to the sum register:
+                        ymm1 = Avx2<int8_t >::MultiplyAndAddAdjacent(ymm1, ymm2);
+                        ymm1 = Avx2<int16_t>::MultiplyAndAddAdjacent(ymm1, one );
+                        ymm0 = Avx2<int32_t>::Add(ymm0, ymm1);
+                    }
+
+                    // Sum up the sum accumulation register and store the result with respect to the bias:
+                    output[i] = Avx2<int32_t>::Sum(ymm0) + bias[i];
+                }
+            }
+#endif
+
+#ifdef MANTARAY_SSE
+            /// \brief The SSE4.1 implementation of Forward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            MANTARAY_TARGET_SSE
+            static void Forward(Target<InstructionSet::Sse>,
+                                const std::array<int8_t, InputSize>& input,
+                                const std::array<int8_t, InputSize * OutputSize>& weight,
+                                const std::array<int32_t, OutputSize>& bias,
+                                std::array<int32_t, OutputSize>& output)
+            {
+                // Define the register used to widen the 16-bit sums into 32-bit sums:
+                const Vec128I one = Sse<int16_t>::From(1);
+
+                // Define the registers used in the inner loop:
+                Vec128I xmm0;
+                Vec128I xmm1;
+                Vec128I xmm2;
+
+                // Define the step size for the loop:
+                constexpr size_t Step = sizeof(Vec128I) / sizeof(int8_t);
+
+                // Define the number of outputs propagated together (one for every 32-bit value of a register), and
+                // the number of outputs in whole groups:
+                constexpr size_t Group   = sizeof(Vec128I) / sizeof(int32_t);
+                constexpr size_t Grouped = OutputSize / Group * Group;
+
+                // Forward propagate the whole groups of outputs, loading every input register once for the group.
+                // The sum registers of the group are then summed up together into a single register of outputs:
+                if constexpr (Grouped > 0) {
+                    // Define the registers for sum accumulation, one for every output of the group:
+                    Vec128I sums[Group];
+
+                    for (size_t i = 0; i < Grouped; i += Group) {
+                        MANTARAY_UNROLL
+                        for (size_t g = 0; g < Group; g++) sums[g] = Sse<int32_t>::Zero();
+
+                        // Inner loop performing sum += input * weight for every output of the group:
+                        for (size_t j = 0; j < InputSize; j += Step) {
+                            // Load the input array into a register:
+                            xmm1 = Sse<int8_t>::From(input, j);
+
+                            MANTARAY_UNROLL
+                            for (size_t g = 0; g < Group; g++) {
+                                // Load the weight array of the output into a register:
+                                xmm2 = Sse<int8_t>::From(weight, (i + g) * InputSize + j);
+
+                                // Multiply and add the 8-bit values into 16-bit sums, widen them into 32-bit sums, and
+                                // add the result to the sum register of the output:
+                                xmm2 = Sse<int8_t >::MultiplyAndAddAdjacent(xmm1, xmm2);
+                                xmm2 = Sse<int16_t>::MultiplyAndAddAdjacent(xmm2, one );
+                                sums[g] = Sse<int32_t>::Add(sums[g], xmm2);
+                            }
+                        }
+
+                        // Sum up the sum accumulation registers together, and store the outputs with respect to the
+                        // bias:
+                        xmm0 = Sse<int32_t>::Sum(sums);
+                        xmm0 = Sse<int32_t>::Add(xmm0, Sse<int32_t>::From(bias, i));
+                        Sse<int32_t>::Store(xmm0, output, i);
+                    }
+                }
+
+                // Forward propagate the remaining outputs one at a time:
+                for (size_t i = Grouped; i < OutputSize; i++) {
+                    const size_t stride = i * InputSize;
+
+                    // Define the register for sum accumulation:
+                    xmm0 = Sse<int32_t>::Zero();
+
+                    // Inner loop performing sum += input * weight:
+                    for (size_t j = 0; j < InputSize; j += Step) {
+                        // Load the input array and weight array into registers:
+                        xmm1 = Sse<int8_t>::From(input ,          j);
+                        xmm2 = Sse<int8_t>::From(weight, stride + j);
+
+                        // Multiply and add the 8-bit values into 16-bit sums, widen them into 32-bit sums, and add the
+                        // result to the sum register:
+                        xmm1 = Sse<int8_t >::MultiplyAndAddAdjacent(xmm1, xmm2);
+                        xmm1 = Sse<int16_t>::MultiplyAndAddAdjacent(xmm1, one );
+                        xmm0 = Sse<int32_t>::Add(xmm0, xmm1);
+                    }
+
+                    // Sum up the sum accumulation register and store the result with respect to the bias:
+                    output[i] = Sse<int32_t>::Sum(xmm0) + bias[i];
+                }
+            }
+#endif
+
+            /// \brief The scalar implementation of Forward().
+            template<size_t InputSize, size_t OutputSize>
+            [[clang::noinline]]
+            static void Forward(Target<InstructionSet::Scalar>,
+                                const std::array<int8_t, InputSize>& input,
+                                const std::array<int8_t, InputSize * OutputSize>& weight,
+                                const std::array<int32_t, OutputSize>& bias,
+                                std::array<int32_t, OutputSize>& output)
+            {
+                for (size_t i = 0; i < OutputSize; i++) {
+                    const size_t stride = i * InputSize;
+
+                    // Define the sum accumulation variable:
+                    int32_t sum = 0;
+
+                    // Add the (unsigned) input multiplied by the weight to the sum:
+                    for (size_t j = 0; j < InputSize; j++)
+                        sum += static_cast<uint8_t>(input[j]) * weight[stride + j];
+
+                    // Store the sum with respect to the bias:
+                    output[i] = sum + bias[i];
                 }
             }
 